@@ -0,0 +1,203 @@
+#ifndef ADAPTADORES_DOS_SENSORES_H
+#define ADAPTADORES_DOS_SENSORES_H
+
+// Reúne todas as implementações de sensores atrás da interface SensorDatabase,
+// para que drivers (ingestão contínua, benchmarks) possam escolher o backend
+// em tempo de execução. Os arquivos das versões são incluídos sem o main().
+// Inclui também as baselines da biblioteca: std::multiset e a árvore de
+// estatística de ordem do __gnu_pbds (quando o compilador oferece).
+#define SENSOR_SEM_MAIN
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<ext/pb_ds/assoc_container.hpp>)
+#include <ext/pb_ds/assoc_container.hpp>
+#include <ext/pb_ds/tree_policy.hpp>
+#define SENSOR_TEM_PBDS
+#endif
+
+#include "Codigo do sensor.cpp"
+#include "Versao basica_lista ordenada.cpp"
+#include "Versao aprimorada_Heap.cpp"
+#include "Versao aprimorada_AVL tree.cpp"
+#include "versao aprimorada_Rubro negra.cpp"
+#ifdef __linux__
+#include "Versao persistente_AVL mapeada.cpp"
+#define SENSOR_TEM_MMAP
+#endif
+
+// Detecta se o sensor tem carga em lote própria (ex: SensorAVL::bulkLoad em O(N))
+template <typename T, typename = void>
+struct TemBulkLoad : false_type {};
+template <typename T>
+struct TemBulkLoad<T, void_t<decltype(declval<T&>().bulkLoad(declval<const vector<double>&>()))>> : true_type {};
+
+// --- Adaptador genérico ---
+// As classes Sensor* têm a mesma API (insert, remove, median...), mas não herdam
+// de SensorDatabase. O adaptador repassa as chamadas e desliga os logs de operação.
+// Assim como em ListaOrdenada/ArvoreBalanceada, rangeQuery e getMinMax não imprimem:
+// usam as versões que devolvem valores e só impedem o compilador de descartá-las.
+template <typename Sensor>
+class AdaptadorSensor : public SensorDatabase {
+private:
+    Sensor sensor;
+    string nome;
+
+public:
+    AdaptadorSensor(const string& n) : nome(n) { sensor.setVerbose(false); }
+
+    string getName() override { return nome; }
+
+    // Alocações do sensor (nós, vetores dos heaps) são creditadas a este backend
+    void insert(double value) override {
+        EscopoMemoria escopo(memoria);
+        sensor.insert(value);
+    }
+    void remove(double value) override {
+        EscopoMemoria escopo(memoria);
+        sensor.remove(value);
+    }
+    void printSorted() override { sensor.printSorted(); }
+    void getMinMax(int k) override {
+        naoOtimizar(sensor.minK(k));
+        naoOtimizar(sensor.maxK(k));
+    }
+    void rangeQuery(double minVal, double maxVal) override { naoOtimizar(sensor.rangeValues(minVal, maxVal)); }
+    double median() override { return sensor.median(); }
+    size_t size() override { return sensor.size(); }
+    double minValue() override { return sensor.minValue(); }
+    double maxValue() override { return sensor.maxValue(); }
+    vector<double> minK(int k) override { return sensor.minK(k); }
+    vector<double> maxK(int k) override { return sensor.maxK(k); }
+
+    void bulkLoad(const vector<double>& sorted) override {
+        if constexpr (TemBulkLoad<Sensor>::value) {
+            EscopoMemoria escopo(memoria);
+            sensor.bulkLoad(sorted);
+        } else {
+            SensorDatabase::bulkLoad(sorted);
+        }
+    }
+};
+
+#ifdef SENSOR_TEM_PBDS
+// --- Baseline: árvore de estatística de ordem do GCC (__gnu_pbds) ---
+// A árvore não aceita chaves repetidas, então cada leitura vira o par
+// (valor, sequência de chegada). Mediana e contagem por faixa em O(log N).
+class ArvorePbds : public SensorDatabase {
+private:
+    using Chave = pair<double, uint64_t>;
+    __gnu_pbds::tree<Chave, __gnu_pbds::null_type, less<Chave>, __gnu_pbds::rb_tree_tag,
+                     __gnu_pbds::tree_order_statistics_node_update> dados;
+    uint64_t sequencia = 0;
+
+public:
+    string getName() override { return "Ordem Estatistica (__gnu_pbds)"; }
+
+    void insert(double value) override {
+        EscopoMemoria escopo(memoria);
+        dados.insert({value, sequencia++});
+    }
+
+    void remove(double value) override {
+        auto it = dados.lower_bound({value, 0}); // Ocorrência mais antiga do valor
+        if (it != dados.end() && it->first == value) dados.erase(it);
+    }
+
+    void printSorted() override {}
+
+    void getMinMax(int k) override {
+        naoOtimizar(minK(k));
+        naoOtimizar(maxK(k));
+    }
+
+    // Contagem pela diferença de posições, sem percorrer a faixa
+    void rangeQuery(double minVal, double maxVal) override {
+        size_t count = dados.order_of_key({maxVal, UINT64_MAX}) - dados.order_of_key({minVal, 0});
+        naoOtimizar(count);
+    }
+
+    double median() override {
+        size_t n = dados.size();
+        if (n == 0) return 0.0;
+        if (n % 2 != 0) return dados.find_by_order(n / 2)->first;
+        return (dados.find_by_order(n / 2 - 1)->first + dados.find_by_order(n / 2)->first) / 2.0;
+    }
+
+    size_t size() override { return dados.size(); }
+    double minValue() override { return dados.empty() ? 0.0 : dados.begin()->first; }
+    double maxValue() override { return dados.empty() ? 0.0 : dados.rbegin()->first; }
+
+    vector<double> minK(int k) override {
+        vector<double> out;
+        for (auto it = dados.begin(); it != dados.end() && (int)out.size() < k; ++it) out.push_back(it->first);
+        return out;
+    }
+
+    vector<double> maxK(int k) override {
+        vector<double> out;
+        for (auto it = dados.rbegin(); it != dados.rend() && (int)out.size() < k; ++it) out.push_back(it->first);
+        return out;
+    }
+};
+#endif
+
+// --- Registro de backends ---
+// Cada entrada liga uma chave curta (linha de comando) a uma fábrica.
+// Programas podem registrar implementações próprias com registrarBackend().
+struct EntradaBackend {
+    string chave;
+    string descricao;
+    function<unique_ptr<SensorDatabase>()> criar;
+    bool medianaPreguicosa = false; // A primeira mediana após alterações paga uma ordenação
+};
+
+inline vector<EntradaBackend>& registroBackends() {
+    static vector<EntradaBackend> registro = {
+        {"lista", "vetor ordenado com insercao deslocando (SensorListaOrdenada)",
+         []() { return make_unique<AdaptadorSensor<SensorListaOrdenada>>("Lista Ordenada (SensorListaOrdenada)"); }},
+        {"heap", "dois heaps com mediana no topo (SensorHeap)",
+         []() { return make_unique<AdaptadorSensor<SensorHeap>>("Dois Heaps (SensorHeap)"); }},
+        {"avl", "AVL com tamanho de subarvore (SensorAVL)",
+         []() { return make_unique<AdaptadorSensor<SensorAVL>>("Arvore AVL (SensorAVL)"); }},
+        {"rb", "rubro-negra LLRB com tamanho de subarvore (SensorRedBlack)",
+         []() { return make_unique<AdaptadorSensor<SensorRedBlack>>("Rubro-Negra (SensorRedBlack)"); }},
+#ifdef SENSOR_TEM_MMAP
+        {"avl-mmap", "AVL com nos num arquivo mapeado, copia no caminho (SensorAVLMapeada)",
+         []() { return make_unique<AdaptadorSensor<SensorAVLMapeada>>("AVL Mapeada (SensorAVLMapeada)"); }},
+#endif
+        {"vetor", "std::vector ordenado (ListaOrdenada)", []() { return make_unique<ListaOrdenada>(); }},
+        {"multiset", "baseline std::multiset (ArvoreBalanceada)", []() { return make_unique<ArvoreBalanceada>(); }},
+#ifdef SENSOR_TEM_PBDS
+        {"pbds", "baseline __gnu_pbds tree com estatistica de ordem", []() { return make_unique<ArvorePbds>(); }},
+#endif
+    };
+    return registro;
+}
+
+inline void registrarBackend(EntradaBackend entrada) { registroBackends().push_back(std::move(entrada)); }
+
+inline const EntradaBackend* buscarBackend(const string& chave) {
+    for (const EntradaBackend& e : registroBackends())
+        if (e.chave == chave) return &e;
+    return nullptr;
+}
+
+inline vector<string> backendsDisponiveis() {
+    vector<string> chaves;
+    for (const EntradaBackend& e : registroBackends()) chaves.push_back(e.chave);
+    return chaves;
+}
+
+inline unique_ptr<SensorDatabase> criarBackend(const string& chave) {
+    const EntradaBackend* e = buscarBackend(chave);
+    return e ? e->criar() : nullptr;
+}
+
+#endif
@@ -1,388 +1,722 @@
-#include <iostream>
-#include <vector>
-#include <algorithm>
-#include <fstream>
-#include <string>
-#include <chrono>
-#include <iomanip>
-#include <cmath>
-
-// Função auxiliar para medição de tempo (evita repetição de código no main)
-template <typename Func>
-long long medirTempo(Func funcao) {
-    auto inicio = std::chrono::steady_clock::now();
-    funcao();
-    auto fim = std::chrono::steady_clock::now();
-    return std::chrono::duration_cast<std::chrono::microseconds>(fim - inicio).count();
-}
-
-// 1. Implementação de Heap Binário (Min-Heap)
-class MinHeapCustomizado {
-private:
-    std::vector<double> _dados;
-
-    // Helpers de índice inline
-    int pai(int i) const { return (i - 1) >> 1; } // Bitwise shift para dividir por 2
-    int filhoEsq(int i) const { return (i << 1) + 1; }
-    int filhoDir(int i) const { return (i << 1) + 2; }
-
-    // "Promover" (Bubble Up)
-    void promoverElemento(int idx) {
-        while (idx > 0) {
-            int p = pai(idx);
-            if (_dados[p] <= _dados[idx]) break; // Propriedade do heap satisfeita
-            std::swap(_dados[idx], _dados[p]);
-            idx = p;
-        }
-    }
-
-    // "Rebaixar" (Sink Down / Heapify)
-    void rebaixarElemento(int idx) {
-        int tam = _dados.size();
-        while (true) {
-            int menor = idx;
-            int esq = filhoEsq(idx);
-            int dir = filhoDir(idx);
-
-            if (esq < tam && _dados[esq] < _dados[menor]) menor = esq;
-            if (dir < tam && _dados[dir] < _dados[menor]) menor = dir;
-
-            if (menor == idx) break;
-
-            std::swap(_dados[idx], _dados[menor]);
-            idx = menor;
-        }
-    }
-
-public:
-    void inserir(double valor) {
-        _dados.push_back(valor);
-        promoverElemento(_dados.size() - 1);
-    }
-
-    void remover(double valor) {
-        // Busca linear substituída por std::find para legibilidade
-        auto it = std::find(_dados.begin(), _dados.end(), valor);
-        
-        if (it == _dados.end()) return; // Não encontrou
-
-        int idx = std::distance(_dados.begin(), it);
-        
-        // Troca com o último e remove
-        _dados[idx] = _dados.back();
-        _dados.pop_back();
-
-        if (idx < _dados.size()) {
-            rebaixarElemento(idx);
-            promoverElemento(idx);
-        }
-    }
-
-    double calcularMediana() {
-        if (_dados.empty()) return 0.0;
-        // Copia e ordena (estratégia ineficiente original mantida propositalmente)
-        std::vector<double> temp = _dados;
-        std::sort(temp.begin(), temp.end());
-        
-        size_t n = temp.size();
-        bool par = (n % 2 == 0);
-        return par ? (temp[n/2 - 1] + temp[n/2]) * 0.5 : temp[n/2];
-    }
-
-    std::vector<double> buscaIntervalo(double min, double max) {
-        std::vector<double> resposta;
-        for (const auto& val : _dados) {
-            if (val >= min && val <= max) resposta.push_back(val);
-        }
-        return resposta;
-    }
-};
-
-// 2. Árvore AVL
-struct NoAVL {
-    double valor;
-    NoAVL *esq = nullptr, *dir = nullptr;
-    int altura = 1;
-    NoAVL(double v) : valor(v) {}
-};
-
-class ArvoreBalanceada {
-private:
-    NoAVL* raiz = nullptr;
-
-    int alt(NoAVL* n) { return n ? n->altura : 0; }
-    int fatorBal(NoAVL* n) { return n ? alt(n->esq) - alt(n->dir) : 0; }
-
-    // Rotações com nomes mais descritivos
-    NoAVL* rotacionarEsquerda(NoAVL* x) {
-        NoAVL* y = x->dir;
-        NoAVL* T2 = y->esq;
-        y->esq = x;
-        x->dir = T2;
-        x->altura = std::max(alt(x->esq), alt(x->dir)) + 1;
-        y->altura = std::max(alt(y->esq), alt(y->dir)) + 1;
-        return y;
-    }
-
-    NoAVL* rotacionarDireita(NoAVL* y) {
-        NoAVL* x = y->esq;
-        NoAVL* T2 = x->dir;
-        x->dir = y;
-        y->esq = T2;
-        y->altura = std::max(alt(y->esq), alt(y->dir)) + 1;
-        x->altura = std::max(alt(x->esq), alt(x->dir)) + 1;
-        return x;
-    }
-
-    NoAVL* inserirRec(NoAVL* no, double chave) {
-        if (!no) return new NoAVL(chave);
-        
-        if (chave < no->valor) no->esq = inserirRec(no->esq, chave);
-        else no->dir = inserirRec(no->dir, chave);
-
-        no->altura = 1 + std::max(alt(no->esq), alt(no->dir));
-        int bal = fatorBal(no);
-
-        // Casos de desbalanceamento
-        if (bal > 1) {
-            if (chave < no->esq->valor) return rotacionarDireita(no);
-            no->esq = rotacionarEsquerda(no->esq);
-            return rotacionarDireita(no);
-        }
-        if (bal < -1) {
-            if (chave >= no->dir->valor) return rotacionarEsquerda(no);
-            no->dir = rotacionarDireita(no->dir);
-            return rotacionarEsquerda(no);
-        }
-        return no;
-    }
-
-    NoAVL* minNo(NoAVL* no) {
-        while (no && no->esq) no = no->esq;
-        return no;
-    }
-
-    NoAVL* removerRec(NoAVL* no, double chave) {
-        if (!no) return nullptr;
-
-        if (chave < no->valor) no->esq = removerRec(no->esq, chave);
-        else if (chave > no->valor) no->dir = removerRec(no->dir, chave);
-        else {
-            // Nó encontrado
-            if (!no->esq || !no->dir) {
-                NoAVL* temp = no->esq ? no->esq : no->dir;
-                if (!temp) { temp = no; no = nullptr; }
-                else *no = *temp;
-                delete temp;
-            } else {
-                NoAVL* temp = minNo(no->dir);
-                no->valor = temp->valor;
-                no->dir = removerRec(no->dir, temp->valor);
-            }
-        }
-
-        if (!no) return nullptr;
-
-        no->altura = 1 + std::max(alt(no->esq), alt(no->dir));
-        int bal = fatorBal(no);
-
-        if (bal > 1 && fatorBal(no->esq) >= 0) return rotacionarDireita(no);
-        if (bal > 1 && fatorBal(no->esq) < 0) {
-            no->esq = rotacionarEsquerda(no->esq);
-            return rotacionarDireita(no);
-        }
-        if (bal < -1 && fatorBal(no->dir) <= 0) return rotacionarEsquerda(no);
-        if (bal < -1 && fatorBal(no->dir) > 0) {
-            no->dir = rotacionarDireita(no->dir);
-            return rotacionarEsquerda(no);
-        }
-        return no;
-    }
-
-    void emOrdem(NoAVL* no, std::vector<double>& lista) {
-        if (!no) return;
-        emOrdem(no->esq, lista);
-        lista.push_back(no->valor);
-        emOrdem(no->dir, lista);
-    }
-
-    void buscarFaixa(NoAVL* no, double min, double max, std::vector<double>& out) {
-        if (!no) return;
-        if (min < no->valor) buscarFaixa(no->esq, min, max, out);
-        if (no->valor >= min && no->valor <= max) out.push_back(no->valor);
-        if (max > no->valor) buscarFaixa(no->dir, min, max, out);
-    }
-
-public:
-    void inserir(double v) { raiz = inserirRec(raiz, v); }
-    void remover(double v) { raiz = removerRec(raiz, v); }
-    
-    std::vector<double> buscaIntervalo(double min, double max) {
-        std::vector<double> res;
-        buscarFaixa(raiz, min, max, res);
-        return res;
-    }
-
-    double calcularMediana() {
-        std::vector<double> ordenados;
-        emOrdem(raiz, ordenados);
-        if (ordenados.empty()) return 0.0;
-        size_t n = ordenados.size();
-        return (n % 2 != 0) ? ordenados[n/2] : (ordenados[n/2 - 1] + ordenados[n/2]) / 2.0;
-    }
-};
-
-// 3. Vetor com Ordenação Preguiçosa (Lazy Insertion Sort)
-class ListaOrdenadaManual {
-private:
-    std::vector<double> _container;
-    bool _estaOrdenado = false;
-
-    // Algoritmo Insertion Sort clássico
-    void ordenarAgora() {
-        int n = _container.size();
-        for (int i = 1; i < n; ++i) {
-            double pivo = _container[i];
-            int j = i - 1;
-            // Loop reescrito de forma mais compacta
-            for (; j >= 0 && _container[j] > pivo; --j) {
-                _container[j + 1] = _container[j];
-            }
-            _container[j + 1] = pivo;
-        }
-        _estaOrdenado = true;
-    }
-
-public:
-    void inserir(double v) {
-        _container.push_back(v);
-        _estaOrdenado = false; // Invalida a ordenação
-    }
-
-    void remover(double v) {
-        // Encontra primeiro elemento e remove
-        auto it = std::find(_container.begin(), _container.end(), v);
-        if (it != _container.end()) {
-            _container.erase(it);
-        }
-    }
-
-    double calcularMediana() {
-        if (_container.empty()) return 0.0;
-        if (!_estaOrdenado) ordenarAgora(); // Lazy sort
-
-        size_t n = _container.size();
-        return (n & 1) ? _container[n/2] : (_container[n/2 - 1] + _container[n/2]) * 0.5;
-    }
-
-    std::vector<double> buscaIntervalo(double min, double max) {
-        std::vector<double> ret;
-        for (double x : _container) {
-            if (x >= min && x <= max) ret.push_back(x);
-        }
-        return ret;
-    }
-};
-
-std::vector<double> carregarArquivo(const std::string& path) {
-    std::vector<double> buffer;
-    std::ifstream arq(path);
-    if (!arq) {
-        std::cerr << "[ERRO] Arquivo '" << path << "' nao encontrado.\n";
-        return buffer;
-    }
-    std::string linha;
-    while (std::getline(arq, linha)) {
-        if (linha.empty()) continue;
-        try { buffer.push_back(std::stod(linha)); } catch (...) {}
-    }
-    return buffer;
-}
-
-int main() {
-    auto dadosBrutos = carregarArquivo("temperaturas.csv");
-    if (dadosBrutos.empty()) {
-        std::cout << "Por favor, crie o arquivo CSV antes de rodar.\n";
-        return 1;
-    }
-
-    std::cout << ">>> Carregados " << dadosBrutos.size() << " registros.\n\n";
-
-    // Instanciação das estruturas
-    MinHeapCustomizado heap;
-    ArvoreBalanceada avl;
-    ListaOrdenadaManual lista;
-
-    // --- TESTE 1: INSERÇÃO ---
-    long tHeapIns = medirTempo([&]() {
-        for (double v : dadosBrutos) heap.inserir(v);
-    });
-    long tAvlIns = medirTempo([&]() {
-        for (double v : dadosBrutos) avl.inserir(v);
-    });
-    long tListIns = medirTempo([&]() {
-        for (double v : dadosBrutos) lista.inserir(v);
-    });
-
-    // --- TESTE 2: MEDIANA ---
-    long tHeapMed = medirTempo([&]() { heap.calcularMediana(); });
-    long tAvlMed  = medirTempo([&]() { avl.calcularMediana(); });
-    long tListMed = medirTempo([&]() { lista.calcularMediana(); });
-
-    // --- TESTE 3: BUSCA POR INTERVALO ---
-    double rangeA = 20.0, rangeB = 30.0;
-    long tHeapBusca = medirTempo([&]() { heap.buscaIntervalo(rangeA, rangeB); });
-    long tAvlBusca  = medirTempo([&]() { avl.buscaIntervalo(rangeA, rangeB); });
-    long tListBusca = medirTempo([&]() { lista.buscaIntervalo(rangeA, rangeB); });
-
-    // --- TESTE 4: REMOÇÃO (Amostra de 100 itens) ---
-    std::vector<double> alvoRemocao;
-    size_t qtdRemover = std::min((size_t)100, dadosBrutos.size());
-    for(size_t i = 0; i < qtdRemover; i++) alvoRemocao.push_back(dadosBrutos[i]);
-
-    long tHeapRem = medirTempo([&]() {
-        for (double v : alvoRemocao) heap.remover(v);
-    });
-    long tAvlRem = medirTempo([&]() {
-        for (double v : alvoRemocao) avl.remover(v);
-    });
-    long tListRem = medirTempo([&]() {
-        for (double v : alvoRemocao) lista.remover(v);
-    });
-
-    // Exibição dos Resultados
-    std::cout << "==============================================================\n";
-    std::cout << "          RELATORIO DE DESEMPENHO (Microsegundos)             \n";
-    std::cout << "==============================================================\n";
-    std::cout << std::left << std::setw(18) << "Cenario" 
-              << std::setw(12) << "MinHeap" 
-              << std::setw(12) << "AVL Tree" 
-              << std::setw(12) << "Vector" 
-              << "Melhor" << std::endl;
-    std::cout << "--------------------------------------------------------------\n";
-
-    auto imprimirLinha = [](std::string nome, long t1, long t2, long t3) {
-        std::string campeao;
-        if (t1 <= t2 && t1 <= t3) campeao = "MinHeap";
-        else if (t2 <= t1 && t2 <= t3) campeao = "AVL Tree";
-        else campeao = "Vector";
-
-        std::cout << std::left << std::setw(18) << nome 
-                  << std::setw(12) << t1 
-                  << std::setw(12) << t2 
-                  << std::setw(12) << t3 
-                  << campeao << std::endl;
-    };
-
-    imprimirLinha("Insercao", tHeapIns, tAvlIns, tListIns);
-    imprimirLinha("Calc. Mediana", tHeapMed, tAvlMed, tListMed);
-    imprimirLinha("Busca Faixa", tHeapBusca, tAvlBusca, tListBusca);
-    imprimirLinha("Remocao (x100)", tHeapRem, tAvlRem, tListRem);
-
-    std::cout << "\n[Analise]:\n";
-    std::cout << "1. Vector eh instantaneo na insercao (append), mas sofre na mediana (ordena tudo).\n";
-    std::cout << "2. AVL eh a estrutura mais estavel para buscas e remocoes.\n";
-    std::cout << "3. Heap eh bom para inserir, mas ruim para buscas arbitras.\n";
-
-    return 0;
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <sstream>
+#include <memory>
+#include <iomanip>
+#include <cmath>
+
+#include <cstdlib>
+#include <limits>
+
+#include "Medicao.h"    // Harness estatístico (aquecimento, lotes, IC, barreiras)
+#include "Resultados.h" // Saída JSON/CSV e modo de comparação
+#include "Memoria.h"    // Contagem de memória por estrutura (bytes vivos, pico, alocações)
+#include "Adaptadores dos sensores.h" // Registro de backends (todas as versões + baselines)
+#include "Persistencia.h"             // WAL + snapshot (modo --persistencia)
+
+// As três estruturas deste benchmark ficam em 'manual' para não colidir com
+// as classes de "Codigo do sensor.cpp" (que também tem uma ArvoreBalanceada).
+namespace manual {
+
+// 1. Implementação de Heap Binário (Min-Heap)
+class MinHeapCustomizado {
+private:
+    std::vector<double> _dados;
+
+    // Helpers de índice inline
+    int pai(int i) const { return (i - 1) >> 1; } // Bitwise shift para dividir por 2
+    int filhoEsq(int i) const { return (i << 1) + 1; }
+    int filhoDir(int i) const { return (i << 1) + 2; }
+
+    // "Promover" (Bubble Up)
+    void promoverElemento(int idx) {
+        while (idx > 0) {
+            int p = pai(idx);
+            if (_dados[p] <= _dados[idx]) break; // Propriedade do heap satisfeita
+            std::swap(_dados[idx], _dados[p]);
+            idx = p;
+        }
+    }
+
+    // "Rebaixar" (Sink Down / Heapify)
+    void rebaixarElemento(int idx) {
+        int tam = _dados.size();
+        while (true) {
+            int menor = idx;
+            int esq = filhoEsq(idx);
+            int dir = filhoDir(idx);
+
+            if (esq < tam && _dados[esq] < _dados[menor]) menor = esq;
+            if (dir < tam && _dados[dir] < _dados[menor]) menor = dir;
+
+            if (menor == idx) break;
+
+            std::swap(_dados[idx], _dados[menor]);
+            idx = menor;
+        }
+    }
+
+public:
+    void inserir(double valor) {
+        _dados.push_back(valor);
+        promoverElemento(_dados.size() - 1);
+    }
+
+    void remover(double valor) {
+        // Busca linear substituída por std::find para legibilidade
+        auto it = std::find(_dados.begin(), _dados.end(), valor);
+        
+        if (it == _dados.end()) return; // Não encontrou
+
+        int idx = std::distance(_dados.begin(), it);
+        
+        // Troca com o último e remove
+        _dados[idx] = _dados.back();
+        _dados.pop_back();
+
+        if (idx < _dados.size()) {
+            rebaixarElemento(idx);
+            promoverElemento(idx);
+        }
+    }
+
+    double calcularMediana() {
+        if (_dados.empty()) return 0.0;
+        // Copia e ordena (estratégia ineficiente original mantida propositalmente)
+        std::vector<double> temp = _dados;
+        std::sort(temp.begin(), temp.end());
+        
+        size_t n = temp.size();
+        bool par = (n % 2 == 0);
+        return par ? (temp[n/2 - 1] + temp[n/2]) * 0.5 : temp[n/2];
+    }
+
+    std::vector<double> buscaIntervalo(double min, double max) {
+        std::vector<double> resposta;
+        for (const auto& val : _dados) {
+            if (val >= min && val <= max) resposta.push_back(val);
+        }
+        return resposta;
+    }
+};
+
+// 2. Árvore AVL
+struct NoAVL {
+    double valor;
+    NoAVL *esq = nullptr, *dir = nullptr;
+    int altura = 1;
+    NoAVL(double v) : valor(v) {}
+};
+
+class ArvoreBalanceada {
+private:
+    NoAVL* raiz = nullptr;
+
+    void liberar(NoAVL* no) {
+        if (!no) return;
+        liberar(no->esq);
+        liberar(no->dir);
+        delete no;
+    }
+
+    int alt(NoAVL* n) { return n ? n->altura : 0; }
+    int fatorBal(NoAVL* n) { return n ? alt(n->esq) - alt(n->dir) : 0; }
+
+    // Rotações com nomes mais descritivos
+    NoAVL* rotacionarEsquerda(NoAVL* x) {
+        NoAVL* y = x->dir;
+        NoAVL* T2 = y->esq;
+        y->esq = x;
+        x->dir = T2;
+        x->altura = std::max(alt(x->esq), alt(x->dir)) + 1;
+        y->altura = std::max(alt(y->esq), alt(y->dir)) + 1;
+        return y;
+    }
+
+    NoAVL* rotacionarDireita(NoAVL* y) {
+        NoAVL* x = y->esq;
+        NoAVL* T2 = x->dir;
+        x->dir = y;
+        y->esq = T2;
+        y->altura = std::max(alt(y->esq), alt(y->dir)) + 1;
+        x->altura = std::max(alt(x->esq), alt(x->dir)) + 1;
+        return x;
+    }
+
+    NoAVL* inserirRec(NoAVL* no, double chave) {
+        if (!no) return new NoAVL(chave);
+        
+        if (chave < no->valor) no->esq = inserirRec(no->esq, chave);
+        else no->dir = inserirRec(no->dir, chave);
+
+        no->altura = 1 + std::max(alt(no->esq), alt(no->dir));
+        int bal = fatorBal(no);
+
+        // Casos de desbalanceamento
+        if (bal > 1) {
+            if (chave < no->esq->valor) return rotacionarDireita(no);
+            no->esq = rotacionarEsquerda(no->esq);
+            return rotacionarDireita(no);
+        }
+        if (bal < -1) {
+            if (chave >= no->dir->valor) return rotacionarEsquerda(no);
+            no->dir = rotacionarDireita(no->dir);
+            return rotacionarEsquerda(no);
+        }
+        return no;
+    }
+
+    NoAVL* minNo(NoAVL* no) {
+        while (no && no->esq) no = no->esq;
+        return no;
+    }
+
+    NoAVL* removerRec(NoAVL* no, double chave) {
+        if (!no) return nullptr;
+
+        if (chave < no->valor) no->esq = removerRec(no->esq, chave);
+        else if (chave > no->valor) no->dir = removerRec(no->dir, chave);
+        else {
+            // Nó encontrado
+            if (!no->esq || !no->dir) {
+                NoAVL* temp = no->esq ? no->esq : no->dir;
+                if (!temp) { temp = no; no = nullptr; }
+                else *no = *temp;
+                delete temp;
+            } else {
+                NoAVL* temp = minNo(no->dir);
+                no->valor = temp->valor;
+                no->dir = removerRec(no->dir, temp->valor);
+            }
+        }
+
+        if (!no) return nullptr;
+
+        no->altura = 1 + std::max(alt(no->esq), alt(no->dir));
+        int bal = fatorBal(no);
+
+        if (bal > 1 && fatorBal(no->esq) >= 0) return rotacionarDireita(no);
+        if (bal > 1 && fatorBal(no->esq) < 0) {
+            no->esq = rotacionarEsquerda(no->esq);
+            return rotacionarDireita(no);
+        }
+        if (bal < -1 && fatorBal(no->dir) <= 0) return rotacionarEsquerda(no);
+        if (bal < -1 && fatorBal(no->dir) > 0) {
+            no->dir = rotacionarDireita(no->dir);
+            return rotacionarEsquerda(no);
+        }
+        return no;
+    }
+
+    void emOrdem(NoAVL* no, std::vector<double>& lista) {
+        if (!no) return;
+        emOrdem(no->esq, lista);
+        lista.push_back(no->valor);
+        emOrdem(no->dir, lista);
+    }
+
+    void buscarFaixa(NoAVL* no, double min, double max, std::vector<double>& out) {
+        if (!no) return;
+        if (min < no->valor) buscarFaixa(no->esq, min, max, out);
+        if (no->valor >= min && no->valor <= max) out.push_back(no->valor);
+        if (max > no->valor) buscarFaixa(no->dir, min, max, out);
+    }
+
+public:
+    ~ArvoreBalanceada() { liberar(raiz); }
+
+    void inserir(double v) { raiz = inserirRec(raiz, v); }
+    void remover(double v) { raiz = removerRec(raiz, v); }
+    
+    std::vector<double> buscaIntervalo(double min, double max) {
+        std::vector<double> res;
+        buscarFaixa(raiz, min, max, res);
+        return res;
+    }
+
+    double calcularMediana() {
+        std::vector<double> ordenados;
+        emOrdem(raiz, ordenados);
+        if (ordenados.empty()) return 0.0;
+        size_t n = ordenados.size();
+        return (n % 2 != 0) ? ordenados[n/2] : (ordenados[n/2 - 1] + ordenados[n/2]) / 2.0;
+    }
+};
+
+// 3. Vetor com Ordenação Preguiçosa (Lazy Insertion Sort)
+class ListaOrdenadaManual {
+private:
+    std::vector<double> _container;
+    bool _estaOrdenado = false;
+
+    // Algoritmo Insertion Sort clássico
+    void ordenarAgora() {
+        int n = _container.size();
+        for (int i = 1; i < n; ++i) {
+            double pivo = _container[i];
+            int j = i - 1;
+            // Loop reescrito de forma mais compacta
+            for (; j >= 0 && _container[j] > pivo; --j) {
+                _container[j + 1] = _container[j];
+            }
+            _container[j + 1] = pivo;
+        }
+        _estaOrdenado = true;
+    }
+
+public:
+    void inserir(double v) {
+        _container.push_back(v);
+        _estaOrdenado = false; // Invalida a ordenação
+    }
+
+    void remover(double v) {
+        // Encontra primeiro elemento e remove
+        auto it = std::find(_container.begin(), _container.end(), v);
+        if (it != _container.end()) {
+            _container.erase(it);
+        }
+    }
+
+    double calcularMediana() {
+        if (_container.empty()) return 0.0;
+        if (!_estaOrdenado) ordenarAgora(); // Lazy sort
+
+        size_t n = _container.size();
+        return (n & 1) ? _container[n/2] : (_container[n/2 - 1] + _container[n/2]) * 0.5;
+    }
+
+    std::vector<double> buscaIntervalo(double min, double max) {
+        std::vector<double> ret;
+        for (double x : _container) {
+            if (x >= min && x <= max) ret.push_back(x);
+        }
+        return ret;
+    }
+};
+
+} // namespace manual
+
+std::vector<double> carregarArquivo(const std::string& path) {
+    std::vector<double> buffer;
+    std::ifstream arq(path);
+    if (!arq) {
+        std::cerr << "[ERRO] Arquivo '" << path << "' nao encontrado.\n";
+        return buffer;
+    }
+    std::string linha;
+    while (std::getline(arq, linha)) {
+        if (linha.empty()) continue;
+        try { buffer.push_back(std::stod(linha)); } catch (...) {}
+    }
+    return buffer;
+}
+
+// --- Adaptador das estruturas manuais para a interface SensorDatabase ---
+// O benchmark mede inserir/remover/mediana/busca; as demais consultas extraem
+// todos os valores e ordenam, o que basta para os drivers que as usam.
+template <typename Estrutura>
+class AdaptadorManual : public SensorDatabase {
+private:
+    Estrutura estrutura;
+    std::string nome;
+
+    std::vector<double> todos() {
+        const double inf = std::numeric_limits<double>::infinity();
+        std::vector<double> v = estrutura.buscaIntervalo(-inf, inf);
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+
+public:
+    explicit AdaptadorManual(const std::string& n) : nome(n) {}
+
+    std::string getName() override { return nome; }
+
+    void insert(double value) override {
+        EscopoMemoria escopo(memoria);
+        estrutura.inserir(value);
+    }
+    void remove(double value) override {
+        EscopoMemoria escopo(memoria);
+        estrutura.remover(value);
+    }
+    void printSorted() override {}
+    void getMinMax(int k) override {
+        naoOtimizar(minK(k));
+        naoOtimizar(maxK(k));
+    }
+    void rangeQuery(double minVal, double maxVal) override { naoOtimizar(estrutura.buscaIntervalo(minVal, maxVal)); }
+    double median() override { return estrutura.calcularMediana(); }
+    size_t size() override { return todos().size(); }
+    double minValue() override {
+        std::vector<double> v = todos();
+        return v.empty() ? 0.0 : v.front();
+    }
+    double maxValue() override {
+        std::vector<double> v = todos();
+        return v.empty() ? 0.0 : v.back();
+    }
+    std::vector<double> minK(int k) override {
+        std::vector<double> v = todos();
+        v.resize(std::min(v.size(), (size_t)std::max(k, 0)));
+        return v;
+    }
+    std::vector<double> maxK(int k) override {
+        std::vector<double> v = todos();
+        std::reverse(v.begin(), v.end());
+        v.resize(std::min(v.size(), (size_t)std::max(k, 0)));
+        return v;
+    }
+};
+
+// Registra as três estruturas deste arquivo ao lado das versões do projeto.
+// Os nomes (getName) são os mesmos dos JSONs antigos, para o modo --comparar.
+void registrarEstruturasManuais() {
+    registrarBackend({"min-heap", "MinHeapCustomizado: heap binario, mediana copia e ordena",
+                      []() { return std::make_unique<AdaptadorManual<manual::MinHeapCustomizado>>("MinHeapCustomizado"); }});
+    registrarBackend({"avl-manual", "ArvoreBalanceada: AVL sem tamanho de subarvore, mediana em ordem",
+                      []() { return std::make_unique<AdaptadorManual<manual::ArvoreBalanceada>>("ArvoreBalanceada"); }});
+    registrarBackend({"vetor-preguicoso", "ListaOrdenadaManual: insertion sort na primeira mediana",
+                      []() { return std::make_unique<AdaptadorManual<manual::ListaOrdenadaManual>>("ListaOrdenadaManual"); },
+                      true});
+}
+
+// Cria um backend novo já carregado com os dados (fora do cronômetro)
+std::unique_ptr<SensorDatabase> carregarBackend(const EntradaBackend& entrada, const std::vector<double>& dados) {
+    std::unique_ptr<SensorDatabase> db = entrada.criar();
+    for (double v : dados) db->insert(v);
+    return db;
+}
+
+// Separa "a,b,c" em chaves
+std::vector<std::string> separarLista(const std::string& texto) {
+    std::vector<std::string> itens;
+    std::stringstream ss(texto);
+    std::string item;
+    while (std::getline(ss, item, ',')) if (!item.empty()) itens.push_back(item);
+    return itens;
+}
+
+void imprimirUso() {
+    std::cerr << "Uso: benchmark [--dados arquivo.csv] [--backends a,b,...] [--json saida.json] [--csv saida.csv] [--sem-contadores]\n"
+              << "       benchmark --comparar base.json novo.json [--limiar PCT]\n"
+              << "       benchmark --persistencia DIR [--dados ...] [--backends ...] [--json ...]\n";
+    std::cerr << "Backends (padrao: todos):\n";
+    for (const EntradaBackend& e : registroBackends())
+        std::cerr << "  " << std::left << std::setw(18) << e.chave << e.descricao << "\n";
+}
+
+// --- MODO PERSISTÊNCIA: custo do WAL por operação e tempo de partida ---
+// Apaga só os arquivos que o BancoPersistente cria no diretório
+void limparDiretorioPersistencia(const std::string& dir) {
+    for (const char* nome : {"wal.log", "snapshot.bin", "snapshot.bin.tmp"}) ::unlink((dir + "/" + nome).c_str());
+}
+
+// Mede um backend: inserção com WAL para vários tamanhos de grupo e recuperação
+// (só WAL, snapshot + cauda do WAL, e o replay do CSV que ela substitui).
+void medirPersistencia(const EntradaBackend& entrada, const std::string& caminhoDados,
+                       const std::vector<double>& dados, const std::string& dir,
+                       std::vector<ResultadoBenchmark>& resultados) {
+    const size_t n = dados.size();
+    const size_t remocoes = std::min((size_t)100, n);
+    std::string distribuicao = "csv:" + caminhoDados;
+    std::string nome = entrada.criar()->getName();
+
+    std::cout << "\n=== Persistencia: " << entrada.chave << " (N = " << n << ") ===\n";
+    std::cout << std::left << std::setw(10) << "Grupo" << std::right << std::setw(14) << "ns/op"
+              << std::setw(12) << "fsyncs" << std::setw(16) << "us/fsync" << std::setw(18) << "fsync ns/op" << std::endl;
+
+    for (size_t grupo : {(size_t)1, (size_t)16, (size_t)256}) {
+        limparDiretorioPersistencia(dir);
+        ConfigPersistencia cfg;
+        cfg.diretorio = dir;
+        cfg.grupo = grupo;
+        cfg.intervaloMs = 1000; // Só o tamanho do grupo decide o fdatasync
+        BancoPersistente banco(entrada.criar(), cfg);
+        if (!banco.abrir()) return;
+
+        long long t0 = agoraNs();
+        for (double v : dados) banco.insert(v);
+        banco.sincronizar();
+        double nsPorOp = (double)(agoraNs() - t0) / n;
+
+        const EstatisticasPersistencia& st = banco.estatisticas();
+        std::cout << std::left << std::setw(10) << grupo << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << nsPorOp << std::setw(12) << st.fsyncs
+                  << std::setw(16) << (st.fsyncs ? st.nsEmFsync / 1000.0 / st.fsyncs : 0.0)
+                  << std::setw(18) << (double)st.nsEmFsync / n << std::endl;
+        resultados.push_back(criarResultado(nome, "insercao_wal_g" + std::to_string(grupo), n, distribuicao,
+                                            medicaoUnica(nsPorOp)));
+    }
+
+    // Alternativa sem persistência: reler o CSV e inserir tudo de novo
+    long long t0 = agoraNs();
+    std::unique_ptr<SensorDatabase> db = carregarBackend(entrada, carregarArquivo(caminhoDados));
+    for (size_t i = 0; i < remocoes; i++) db->remove(dados[i]);
+    double msCsv = (agoraNs() - t0) * 1e-6;
+    size_t esperado = db->size();
+
+    // Estado a recuperar: N inserções + 'remocoes' remoções (com ou sem snapshot no meio)
+    auto gravarEstado = [&](bool comSnapshot) {
+        limparDiretorioPersistencia(dir);
+        ConfigPersistencia cfg;
+        cfg.diretorio = dir;
+        cfg.grupo = 256;
+        BancoPersistente banco(entrada.criar(), cfg);
+        banco.abrir();
+        for (double v : dados) banco.insert(v);
+        if (comSnapshot) banco.snapshot();
+        for (size_t i = 0; i < remocoes; i++) banco.remove(dados[i]);
+    };
+    auto recuperar = [&](RelatorioRecuperacao& rel) {
+        ConfigPersistencia cfg;
+        cfg.diretorio = dir;
+        long long t0 = agoraNs();
+        BancoPersistente banco(entrada.criar(), cfg);
+        banco.abrir(&rel);
+        double ms = (agoraNs() - t0) * 1e-6;
+        if (banco.size() != esperado || banco.median() != db->median())
+            std::cout << "[ERRO] Estado recuperado difere: " << banco.size() << " leituras (esperado " << esperado << ")\n";
+        return ms;
+    };
+
+    RelatorioRecuperacao soWal, comSnapshot;
+    gravarEstado(false);
+    double msSoWal = recuperar(soWal);
+    gravarEstado(true);
+    double msSnapshot = recuperar(comSnapshot);
+    limparDiretorioPersistencia(dir);
+
+    std::cout << "Partida: so WAL (" << soWal.opsReaplicadas << " ops) " << std::setprecision(2) << msSoWal
+              << " ms | snapshot (" << comSnapshot.leiturasSnapshot << " leituras) + WAL ("
+              << comSnapshot.opsReaplicadas << " ops) " << msSnapshot << " ms | replay do CSV " << msCsv << " ms"
+              << std::endl;
+    resultados.push_back(criarResultado(nome, "partida_wal", n, distribuicao, medicaoUnica(msSoWal * 1e6 / n)));
+    resultados.push_back(criarResultado(nome, "partida_snapshot", n, distribuicao, medicaoUnica(msSnapshot * 1e6 / n)));
+}
+
+// Medições de um backend nos quatro cenários
+const int NUM_CENARIOS = 4;
+const char* CENARIOS[NUM_CENARIOS] = {"Insercao", "Calc. Mediana", "Busca Faixa", "Remocao (x100)"};
+const char* OPERACOES[NUM_CENARIOS] = {"insercao", "mediana", "busca_faixa", "remocao"};
+
+struct MedicaoBackend {
+    const EntradaBackend* entrada = nullptr;
+    std::string nome;
+    Estatisticas cenario[NUM_CENARIOS];
+    UsoMemoria memoria;
+};
+
+int main(int argc, char** argv) {
+    registrarEstruturasManuais();
+
+    std::string caminhoDados = "temperaturas.csv";
+    std::vector<std::string> saidas;
+    std::string base, novo;
+    double limiarPct = 5.0;
+    bool usarContadores = true;
+    std::string dirPersistencia;
+    std::vector<std::string> chaves = backendsDisponiveis();
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        if (arg == "--dados" && temValor) caminhoDados = argv[++i];
+        else if ((arg == "--json" || arg == "--csv") && temValor) saidas.push_back(argv[++i]);
+        else if (arg == "--comparar" && i + 2 < argc) { base = argv[++i]; novo = argv[++i]; }
+        else if (arg == "--limiar" && temValor) limiarPct = std::atof(argv[++i]);
+        else if (arg == "--backends" && temValor) chaves = separarLista(argv[++i]);
+        else if (arg == "--sem-contadores") usarContadores = false;
+        else if (arg == "--persistencia" && temValor) dirPersistencia = argv[++i];
+        else { imprimirUso(); return 1; }
+    }
+
+    // --- MODO COMPARAÇÃO: diff entre duas execuções ---
+    if (!base.empty()) {
+        auto resultadosBase = carregarResultados(base);
+        auto resultadosNovo = carregarResultados(novo);
+        if (resultadosBase.empty() || resultadosNovo.empty()) return 2;
+        return compararResultados(resultadosBase, resultadosNovo, limiarPct) > 0 ? 1 : 0;
+    }
+
+    std::vector<MedicaoBackend> medicoes;
+    for (const std::string& chave : chaves) {
+        const EntradaBackend* entrada = buscarBackend(chave);
+        if (!entrada) {
+            std::cerr << "[ERRO] Backend desconhecido: " << chave << "\n";
+            imprimirUso();
+            return 1;
+        }
+        MedicaoBackend m;
+        m.entrada = entrada;
+        medicoes.push_back(m);
+    }
+
+    auto dadosBrutos = carregarArquivo(caminhoDados);
+    if (dadosBrutos.empty()) {
+        std::cout << "Por favor, crie o arquivo CSV antes de rodar.\n";
+        return 1;
+    }
+
+    std::cout << ">>> Carregados " << dadosBrutos.size() << " registros.\n\n";
+
+    if (!dirPersistencia.empty()) {
+        std::vector<ResultadoBenchmark> resultados;
+        std::cout << "Persistencia em '" << dirPersistencia << "' (ns/op inclui a operacao em memoria)\n";
+        for (const MedicaoBackend& m : medicoes)
+            medirPersistencia(*m.entrada, caminhoDados, dadosBrutos, dirPersistencia, resultados);
+        for (const std::string& caminho : saidas) {
+            if (!salvarResultados(caminho, resultados)) return 1;
+            std::cout << "Resultados salvos em '" << caminho << "'.\n";
+        }
+        return 0;
+    }
+
+    ConfigMedicao cfg;
+    long long n = dadosBrutos.size();
+
+    // Contadores de hardware: sem suporte (VM, container, perf_event_paranoid)
+    // o benchmark segue só com o tempo de parede.
+    std::unique_ptr<ContadoresHardware> contadores;
+    if (usarContadores) {
+        contadores = std::make_unique<ContadoresHardware>();
+        if (contadores->disponivel()) cfg.contadores = contadores.get();
+        else std::cout << "[Aviso] Contadores de hardware indisponiveis ("
+                       << contadores->motivoIndisponivel() << "); medindo apenas tempo.\n\n";
+    }
+
+    double rangeA = 20.0, rangeB = 30.0;
+    std::vector<double> alvoRemocao;
+    size_t qtdRemover = std::min((size_t)100, dadosBrutos.size());
+    for(size_t i = 0; i < qtdRemover; i++) alvoRemocao.push_back(dadosBrutos[i]);
+
+    // Todos os backends recebem os mesmos dados, faixas e alvos de remoção
+    for (MedicaoBackend& m : medicoes) {
+        const EntradaBackend& entrada = *m.entrada;
+        std::unique_ptr<SensorDatabase> db;
+
+        // --- TESTE 1: INSERÇÃO (estrutura vazia a cada amostra) ---
+        m.cenario[0] = medirComPreparo([&]() { db = entrada.criar(); },
+                                       [&]() { for (double v : dadosBrutos) db->insert(v); },
+                                       n, cfg);
+        m.nome = db->getName();
+
+        // --- TESTE 2: MEDIANA ---
+        // A maioria pode ser repetida em lote. Backends com ordenação preguiçosa
+        // ordenam na primeira chamada; para medir esse custo real, são recarregados
+        // antes de cada amostra.
+        db = carregarBackend(entrada, dadosBrutos);
+        m.memoria = db->memoryUsage();
+        if (entrada.medianaPreguicosa)
+            m.cenario[1] = medirComPreparo([&]() { db = carregarBackend(entrada, dadosBrutos); },
+                                           [&]() { naoOtimizar(db->median()); }, 1, cfg);
+        else
+            m.cenario[1] = medirRepetivel([&]() { return db->median(); }, cfg);
+
+        // --- TESTE 3: BUSCA POR INTERVALO ---
+        m.cenario[2] = medirRepetivel([&]() { db->rangeQuery(rangeA, rangeB); return 0; }, cfg);
+
+        // --- TESTE 4: REMOÇÃO (Amostra de 100 itens, estrutura recarregada a cada amostra) ---
+        m.cenario[3] = medirComPreparo([&]() { db = carregarBackend(entrada, dadosBrutos); },
+                                       [&]() { for (double v : alvoRemocao) db->remove(v); },
+                                       qtdRemover, cfg);
+    }
+
+    // Exibição dos Resultados: um bloco por cenário, do mais rápido ao mais lento.
+    // Só declara vencedor se o IC 95% do melhor não se sobrepõe ao do segundo.
+    std::cout << "==========================================================================\n";
+    std::cout << "      RELATORIO DE DESEMPENHO (ns/op, mediana de " << cfg.amostras << " amostras)\n";
+    std::cout << "==========================================================================\n";
+    std::cout << std::left << std::setw(18) << "Cenario" << std::setw(18) << "Estrutura"
+              << std::right << std::setw(12) << "Minimo" << std::setw(12) << "Mediana"
+              << std::setw(12) << "p95" << std::setw(26) << "IC95% mediana" << std::setw(10) << "Lote" << std::endl;
+
+    for (int c = 0; c < NUM_CENARIOS; c++) {
+        std::vector<const MedicaoBackend*> ranking;
+        for (const MedicaoBackend& m : medicoes) ranking.push_back(&m);
+        std::sort(ranking.begin(), ranking.end(), [c](const MedicaoBackend* a, const MedicaoBackend* b) {
+            return a->cenario[c].mediana < b->cenario[c].mediana;
+        });
+
+        std::cout << "--------------------------------------------------------------------------\n";
+        for (const MedicaoBackend* m : ranking) {
+            const Estatisticas& e = m->cenario[c];
+            std::ostringstream ic;
+            ic << std::fixed << std::setprecision(1) << "[" << e.icInferior << ", " << e.icSuperior << "]";
+            std::cout << std::left << std::setw(18) << CENARIOS[c] << std::setw(18) << m->entrada->chave << std::right
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(12) << e.minimo << std::setw(12) << e.mediana << std::setw(12) << e.p95
+                      << std::setw(26) << ic.str()
+                      << std::setw(10) << e.iteracoesPorAmostra << std::endl;
+        }
+        std::string campeao = ranking[0]->entrada->chave;
+        if (ranking.size() > 1 && !significativamenteMenor(ranking[0]->cenario[c], ranking[1]->cenario[c]))
+            campeao = "Empate (" + ranking[0]->entrada->chave + "/" + ranking[1]->entrada->chave + ")";
+        std::cout << std::left << std::setw(18) << "" << "Melhor: " << campeao << std::endl;
+    }
+
+    // Contadores de hardware por operação, ao lado do tempo de parede
+    if (cfg.contadores) {
+        std::cout << "\n--- Contadores de hardware (por operacao) ---\n";
+        std::cout << std::left << std::setw(18) << "Cenario" << std::setw(18) << "Estrutura" << std::right
+                  << std::setw(12) << "ns/op";
+        for (int h = 0; h < NUM_CONTADORES_HW; h++) std::cout << std::setw(12) << nomeContadorHW(h);
+        std::cout << std::setw(8) << "IPC" << std::endl;
+
+        for (int c = 0; c < NUM_CENARIOS; c++) {
+            for (const MedicaoBackend& m : medicoes) {
+                const Estatisticas& est = m.cenario[c];
+                const LeituraContadores& hw = est.contadores;
+                std::cout << std::left << std::setw(18) << CENARIOS[c] << std::setw(18) << m.entrada->chave << std::right
+                          << std::fixed << std::setprecision(1) << std::setw(12) << est.mediana;
+                for (int h = 0; h < NUM_CONTADORES_HW; h++) {
+                    if (hw.disponivel[h]) std::cout << std::setw(12) << hw.valor[h];
+                    else std::cout << std::setw(12) << "n/d";
+                }
+                if (hw.disponivel[HW_CICLOS] && hw.disponivel[HW_INSTRUCOES] && hw.valor[HW_CICLOS] > 0)
+                    std::cout << std::setw(8) << std::setprecision(2) << hw.valor[HW_INSTRUCOES] / hw.valor[HW_CICLOS];
+                else
+                    std::cout << std::setw(8) << "n/d";
+                std::cout << std::endl;
+            }
+        }
+    }
+
+    // Memória de cada estrutura com os N elementos carregados
+    std::cout << "\n--- Memoria (N = " << n << ") ---\n";
+    std::cout << std::left << std::setw(18) << "Estrutura" << std::right << std::setw(14) << "Bytes/elem"
+              << std::setw(14) << "Vivos (KB)" << std::setw(14) << "Pico (KB)" << std::setw(12) << "Alocacoes" << std::endl;
+    for (const MedicaoBackend& m : medicoes) {
+        std::cout << std::left << std::setw(18) << m.entrada->chave << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << (n ? (double)m.memoria.bytesVivos / n : 0.0)
+                  << std::setw(14) << m.memoria.bytesVivos / 1024.0
+                  << std::setw(14) << m.memoria.bytesPico / 1024.0 << std::setw(12) << m.memoria.alocacoes << std::endl;
+    }
+
+    std::cout << "\n[Analise]:\n";
+    std::cout << "1. vetor-preguicoso eh instantaneo na insercao (append), mas sofre na mediana (ordena tudo).\n";
+    std::cout << "2. Arvores balanceadas sao as estruturas mais estaveis para buscas e remocoes.\n";
+    std::cout << "3. Heaps sao bons para inserir, mas ruins para buscas arbitrarias.\n";
+    std::cout << "4. 'Empate' = diferenca dentro do ruido de medicao (ICs 95% se sobrepoem).\n";
+
+    // --- Saída em formato de máquina ---
+    if (!saidas.empty()) {
+        std::string distribuicao = "csv:" + caminhoDados;
+
+        std::vector<ResultadoBenchmark> resultados;
+        for (int c = 0; c < NUM_CENARIOS; c++)
+            for (const MedicaoBackend& m : medicoes)
+                resultados.push_back(criarResultado(m.nome, OPERACOES[c], n, distribuicao, m.cenario[c],
+                                                    n ? (double)m.memoria.bytesVivos / n : 0.0));
+        for (const std::string& caminho : saidas) {
+            if (!salvarResultados(caminho, resultados)) return 1;
+            std::cout << "Resultados salvos em '" << caminho << "'.\n";
+        }
+    }
+
+    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,232 @@
+// Gerador de carga mista (estilo YCSB): intercala inserções, remoções, medianas,
+// buscas por faixa e top-k sobre um backend, com padrões de chave configuráveis,
+// e registra a latência de cada operação em histogramas HDR (p50/p99/p99.9).
+//
+// Uso:
+//   ./carga_mista [--backend NOME] [--n-inicial N] [--ops N] [--chaves PADRAO]
+//                 [--mix insert=50,remove=20,median=20,range=5,topk=5] [--k K] [--semente S]
+//
+// Padrões de chave:
+//   random  - valores uniformes; remoções e faixas em chaves aleatórias
+//   recent  - valores em passeio aleatório (temperatura variando devagar);
+//             remoções e faixas concentradas nas leituras mais recentes
+//   sorted  - valores crescentes; remoções sempre da leitura mais antiga (FIFO)
+//   absent  - inserções aleatórias; remoções e faixas em chaves que não existem
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <deque>
+#include <random>
+#include <cstdlib>
+
+#include "Adaptadores dos sensores.h"
+#include "Histograma.h"
+
+enum Operacao { OP_INSERT, OP_REMOVE, OP_MEDIAN, OP_RANGE, OP_TOPK, NUM_OPS };
+const char* NOMES_OPS[NUM_OPS] = {"insert", "remove", "median", "range", "topk"};
+
+struct ConfigCarga {
+    string backend = "avl";
+    string chaves = "random";
+    size_t nInicial = 100000;
+    size_t ops = 200000;
+    int k = 10;
+    unsigned semente = 42;
+    double mix[NUM_OPS] = {50, 20, 20, 5, 5};
+};
+
+const double TEMP_MIN = -10.0, TEMP_MAX = 45.0;
+const double LARGURA_FAIXA = 1.0; // Faixa de 1 grau por consulta
+
+// --- Gerador de chaves por padrão ---
+// Mantém as leituras vivas em ordem de chegada para escolher alvos de remoção.
+class GeradorChaves {
+private:
+    string padrao;
+    mt19937_64 rng;
+    uniform_real_distribution<double> uniforme{TEMP_MIN, TEMP_MAX};
+    normal_distribution<double> passo{0.0, 0.05};
+    geometric_distribution<size_t> recencia{0.01}; // ~100 leituras mais recentes
+    double atual = 20.0, proximaOrdenada = TEMP_MIN;
+    deque<double> vivas;
+
+    // Arredonda para 2 casas, como os sensores reais
+    static double quantizar(double v) { return std::round(v * 100.0) / 100.0; }
+
+    size_t indiceAlvo() {
+        if (padrao == "recent") {
+            size_t d = min(recencia(rng), vivas.size() - 1);
+            return vivas.size() - 1 - d;
+        }
+        if (padrao == "sorted") return 0;
+        return uniform_int_distribution<size_t>(0, vivas.size() - 1)(rng);
+    }
+
+public:
+    GeradorChaves(const string& p, unsigned semente) : padrao(p), rng(semente) {}
+
+    double novaLeitura() {
+        double v;
+        if (padrao == "recent") {
+            atual = min(TEMP_MAX, max(TEMP_MIN, atual + passo(rng)));
+            v = atual;
+        } else if (padrao == "sorted") {
+            proximaOrdenada += 0.01;
+            v = proximaOrdenada;
+        } else {
+            v = uniforme(rng);
+        }
+        v = quantizar(v);
+        vivas.push_back(v);
+        return v;
+    }
+
+    // Chave a remover; 'existe' = false quando o padrão pede uma chave ausente
+    double alvoRemocao(bool& existe) {
+        existe = padrao != "absent" && !vivas.empty();
+        if (!existe) return quantizar(uniforme(rng)) + 0.005; // Fora da grade de 0.01
+        size_t i = indiceAlvo();
+        double v = vivas[i];
+        if (padrao == "sorted") vivas.pop_front();
+        else {
+            vivas[i] = vivas.back(); // Troca com o último (O(1))
+            vivas.pop_back();
+        }
+        return v;
+    }
+
+    // Início de uma faixa de consulta
+    double inicioFaixa() {
+        if (padrao == "absent") return TEMP_MAX + 10.0; // Nenhuma leitura acima do máximo
+        if (vivas.empty()) return uniforme(rng);
+        return vivas[indiceAlvo()] - LARGURA_FAIXA / 2;
+    }
+};
+
+bool lerMix(const string& texto, double mix[NUM_OPS]) {
+    for (int i = 0; i < NUM_OPS; i++) mix[i] = 0;
+    size_t pos = 0;
+    while (pos < texto.size()) {
+        size_t fim = texto.find(',', pos);
+        if (fim == string::npos) fim = texto.size();
+        string par = texto.substr(pos, fim - pos);
+        size_t igual = par.find('=');
+        if (igual == string::npos) return false;
+        string nome = par.substr(0, igual);
+        bool achou = false;
+        for (int i = 0; i < NUM_OPS; i++) {
+            if (nome == NOMES_OPS[i]) { mix[i] = atof(par.c_str() + igual + 1); achou = true; }
+        }
+        if (!achou) return false;
+        pos = fim + 1;
+    }
+    return true;
+}
+
+void imprimirUso() {
+    cerr << "Uso: carga_mista [--backend NOME] [--n-inicial N] [--ops N] [--chaves random|recent|sorted|absent]\n"
+         << "                 [--mix insert=50,remove=20,median=20,range=5,topk=5] [--k K] [--semente S]\n";
+    cerr << "Backends:";
+    for (const string& b : backendsDisponiveis()) cerr << " " << b;
+    cerr << endl;
+}
+
+int main(int argc, char** argv) {
+    ConfigCarga cfg;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        if (arg == "--backend" && temValor) cfg.backend = argv[++i];
+        else if (arg == "--chaves" && temValor) cfg.chaves = argv[++i];
+        else if (arg == "--n-inicial" && temValor) cfg.nInicial = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--ops" && temValor) cfg.ops = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--k" && temValor) cfg.k = atoi(argv[++i]);
+        else if (arg == "--semente" && temValor) cfg.semente = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--mix" && temValor) {
+            if (!lerMix(argv[++i], cfg.mix)) {
+                cerr << "[ERRO] Mix invalido: " << argv[i] << endl;
+                return 1;
+            }
+        } else {
+            imprimirUso();
+            return 1;
+        }
+    }
+
+    if (cfg.chaves != "random" && cfg.chaves != "recent" && cfg.chaves != "sorted" && cfg.chaves != "absent") {
+        cerr << "[ERRO] Padrao de chaves desconhecido: " << cfg.chaves << endl;
+        return 1;
+    }
+    unique_ptr<SensorDatabase> db = criarBackend(cfg.backend);
+    if (!db) {
+        cerr << "[ERRO] Backend desconhecido: " << cfg.backend << endl;
+        imprimirUso();
+        return 1;
+    }
+
+    GeradorChaves chaves(cfg.chaves, cfg.semente);
+    mt19937_64 rng(cfg.semente + 1);
+    discrete_distribution<int> sorteioOp(cfg.mix, cfg.mix + NUM_OPS);
+
+    // Carga inicial (fora das medições)
+    for (size_t i = 0; i < cfg.nInicial; i++) db->insert(chaves.novaLeitura());
+
+    cout << ">>> Carga mista: backend=" << db->getName() << " chaves=" << cfg.chaves
+         << " n-inicial=" << cfg.nInicial << " ops=" << cfg.ops << endl;
+    cout << "Mix (%):";
+    double somaMix = 0;
+    for (int i = 0; i < NUM_OPS; i++) somaMix += cfg.mix[i];
+    for (int i = 0; i < NUM_OPS; i++) cout << " " << NOMES_OPS[i] << "=" << fixed << setprecision(1) << 100 * cfg.mix[i] / somaMix;
+    cout << endl;
+
+    HistogramaLatencia histogramas[NUM_OPS];
+    long long inicioTotal = agoraNs();
+
+    for (size_t i = 0; i < cfg.ops; i++) {
+        int op = sorteioOp(rng);
+        // Parâmetros escolhidos antes do cronômetro
+        double valor = 0, inicioFaixa = 0;
+        bool existe = true;
+        if (op == OP_INSERT) valor = chaves.novaLeitura();
+        else if (op == OP_REMOVE) valor = chaves.alvoRemocao(existe);
+        else if (op == OP_RANGE) inicioFaixa = chaves.inicioFaixa();
+
+        long long t0 = agoraNs();
+        switch (op) {
+            case OP_INSERT: db->insert(valor); break;
+            case OP_REMOVE: db->remove(valor); break;
+            case OP_MEDIAN: naoOtimizar(db->median()); break;
+            case OP_RANGE: db->rangeQuery(inicioFaixa, inicioFaixa + LARGURA_FAIXA); break;
+            case OP_TOPK:
+                naoOtimizar(db->minK(cfg.k));
+                naoOtimizar(db->maxK(cfg.k));
+                break;
+        }
+        histogramas[op].registrar(agoraNs() - t0);
+    }
+
+    double segundos = (agoraNs() - inicioTotal) * 1e-9;
+
+    cout << "\n" << left << setw(10) << "Operacao" << right << setw(10) << "Qtd"
+         << setw(12) << "Media" << setw(12) << "p50" << setw(12) << "p99"
+         << setw(12) << "p99.9" << setw(14) << "Max" << "   (ns)" << endl;
+    HistogramaLatencia todas;
+    for (int op = 0; op < NUM_OPS; op++) {
+        const HistogramaLatencia& h = histogramas[op];
+        todas.somar(h);
+        if (h.quantidade() == 0) continue;
+        cout << left << setw(10) << NOMES_OPS[op] << right << setw(10) << h.quantidade()
+             << fixed << setprecision(0) << setw(12) << h.media()
+             << setw(12) << h.percentil(50) << setw(12) << h.percentil(99)
+             << setw(12) << h.percentil(99.9) << setw(14) << h.valorMaximo() << endl;
+    }
+    cout << left << setw(10) << "todas" << right << setw(10) << todas.quantidade()
+         << setw(12) << todas.media() << setw(12) << todas.percentil(50) << setw(12) << todas.percentil(99)
+         << setw(12) << todas.percentil(99.9) << setw(14) << todas.valorMaximo() << endl;
+
+    cout << "\nVazao: " << fixed << setprecision(0) << (segundos > 0 ? cfg.ops / segundos : 0.0)
+         << " ops/s | Leituras ao final: " << db->size() << endl;
+    return 0;
+}
@@ -1,221 +1,377 @@
-#include <iostream>
-#include <vector>
-#include <set>
-#include <algorithm> // para sort, lower_bound
-#include <iterator>
-#include <chrono>    // para medir o tempo
-#include <cmath>     // para infinity
-#include <iomanip>
-
-using namespace std;
-
-// --- Interface Abstrata (Define o que todo "Banco de Sensores" deve ter) ---
-class SensorDatabase {
-public:
-    virtual void insert(double value) = 0;
-    virtual void remove(double value) = 0;
-    virtual void printSorted() = 0;
-    virtual void getMinMax(int k) = 0; // Ex: 3 menores e 3 maiores
-    virtual void rangeQuery(double minVal, double maxVal) = 0;
-    virtual double median() = 0;
-    virtual string getName() = 0; // Para identificar nos testes
-    virtual ~SensorDatabase() {}
-};
-
-// --- IMPLEMENTAÇÃO 1: Versão Básica (Lista Ordenada / Insertion Sort) ---
-// Inserção lenta O(N), Leitura rápida O(1)
-class ListaOrdenada : public SensorDatabase {
-private:
-    vector<double> dados;
-
-public:
-    string getName() override { return "Versao Basica (Vector)"; }
-
-    void insert(double value) override {
-        // Encontra a posição correta para manter ordenado (Busca Binária)
-        auto it = lower_bound(dados.begin(), dados.end(), value);
-        // Insere o valor (Isso é LENTO pois desloca todos os elementos à frente)
-        dados.insert(it, value);
-    }
-
-    void remove(double value) override {
-        auto it = lower_bound(dados.begin(), dados.end(), value);
-        if (it != dados.end() && *it == value) {
-            dados.erase(it); // Também lento, desloca elementos
-        }
-    }
-
-    void printSorted() override {
-        // Já está ordenado
-        // for (double v : dados) cout << v << " "; cout << endl; // Comentado para não poluir testes grandes
-    }
-
-    void getMinMax(int k) override {
-        if (dados.empty()) return;
-        int n = dados.size();
-        k = min(k, n);
-        
-        // Acesso direto O(1)
-        // cout << "Minimos: ";
-        // for(int i=0; i<k; i++) cout << dados[i] << " ";
-        // cout << " | Maximos: ";
-        // for(int i=0; i<k; i++) cout << dados[n-1-i] << " ";
-        // cout << endl;
-    }
-
-    void rangeQuery(double minVal, double maxVal) override {
-        auto itStart = lower_bound(dados.begin(), dados.end(), minVal);
-        auto itEnd = upper_bound(dados.begin(), dados.end(), maxVal);
-        
-        // Apenas itera sobre os elementos no intervalo
-        int count = 0;
-        for (auto it = itStart; it != itEnd; ++it) {
-            count++; // Apenas contando para teste de performance
-        }
-    }
-
-    double median() override {
-        if (dados.empty()) return 0.0;
-        if (dados.size() % 2 == 0) {
-            return (dados[dados.size()/2 - 1] + dados[dados.size()/2]) / 2.0;
-        } else {
-            return dados[dados.size()/2];
-        }
-    }
-};
-
-// --- IMPLEMENTAÇÃO 2: Versão Aprimorada (Árvore Balanceada) ---
-// Inserção rápida O(log N), Remoção rápida O(log N)
-class ArvoreBalanceada : public SensorDatabase {
-private:
-    // multiset permite valores duplicados e mantém ordenação automática (Árvore Rubro-Negra)
-    multiset<double> dados; 
-
-public:
-    string getName() override { return "Versao Aprimorada (Tree/Multiset)"; }
-
-    void insert(double value) override {
-        dados.insert(value); // O(log N) - Muito mais rápido
-    }
-
-    void remove(double value) override {
-        auto it = dados.find(value);
-        if (it != dados.end()) {
-            dados.erase(it); // O(log N)
-        }
-    }
-
-    void printSorted() override {
-        // Em-ordem (in-order traversal) implícito
-        // for (double v : dados) cout << v << " "; cout << endl;
-    }
-
-    void getMinMax(int k) override {
-        if (dados.empty()) return;
-        int n = dados.size();
-        k = min(k, n);
-
-        // Iteradores bidirecionais
-        // auto it = dados.begin();
-        // cout << "Minimos: ";
-        // for(int i=0; i<k; i++) cout << *it++ << " ";
-        
-        // auto rit = dados.rbegin();
-        // cout << " | Maximos: ";
-        // for(int i=0; i<k; i++) cout << *rit++ << " ";
-        // cout << endl;
-    }
-
-    void rangeQuery(double minVal, double maxVal) override {
-        // Busca o início e fim do intervalo em O(log N)
-        auto itStart = dados.lower_bound(minVal);
-        auto itEnd = dados.upper_bound(maxVal);
-
-        int count = 0;
-        for (auto it = itStart; it != itEnd; ++it) {
-            count++;
-        }
-    }
-
-    double median() override {
-        if (dados.empty()) return 0.0;
-        size_t size = dados.size();
-        auto it = dados.begin();
-        
-        // Ponto de atenção: Em std::multiset, chegar ao meio custa O(N/2)
-        // Para O(log N) real, seria necessário implementar uma AVL manual com contagem de nós.
-        // Mas para este exercício, a vantagem na inserção compensa.
-        std::advance(it, size / 2);
-        
-        if (size % 2 != 0) {
-            return *it;
-        } else {
-            double val1 = *it;
-            std::advance(it, -1); // volta um
-            double val2 = *it;
-            return (val1 + val2) / 2.0;
-        }
-    }
-};
-
-// --- FUNÇÃO AUXILIAR PARA TESTE DE PERFORMANCE ---
-void runBenchmark(SensorDatabase* db, int dataSize) {
-    // Gerar dados aleatórios
-    vector<double> inputData;
-    inputData.reserve(dataSize);
-    for(int i=0; i<dataSize; i++) {
-        inputData.push_back((rand() % 10000) / 10.0); // Temps entre 0.0 e 1000.0
-    }
-
-    cout << "--- Testando " << db->getName() << " com " << dataSize << " elementos ---" << endl;
-
-    // 1. Medir Tempo de Inserção
-    auto start = chrono::high_resolution_clock::now();
-    for (double v : inputData) {
-        db->insert(v);
-    }
-    auto end = chrono::high_resolution_clock::now();
-    chrono::duration<double> diff = end - start;
-    cout << "Insercao: " << fixed << setprecision(4) << diff.count() << " s" << endl;
-
-    // 2. Medir Range Query (Consulta)
-    start = chrono::high_resolution_clock::now();
-    for(int i=0; i<1000; i++) { // Executa 1000 consultas
-        db->rangeQuery(200.0, 500.0); 
-    }
-    end = chrono::high_resolution_clock::now();
-    diff = end - start;
-    cout << "1000 Consultas (Range): " << diff.count() << " s" << endl;
-
-    // 3. Medir Mediana
-    start = chrono::high_resolution_clock::now();
-    volatile double m = db->median(); // volatile para o compilador não otimizar
-    end = chrono::high_resolution_clock::now();
-    diff = end - start;
-    cout << "Calculo da Mediana: " << diff.count() << " s" << endl;
-
-    cout << "------------------------------------------------" << endl;
-}
-
-int main() {
-    // Configura semente aleatória
-    srand(time(0));
-
-    // Define tamanhos de teste: Pequeno, Médio, Grande
-    vector<int> tamanhos = {1000, 10000, 50000}; 
-    // OBS: 50.000 na lista ordenada já vai demorar alguns segundos.
-    // 100.000 ou mais pode travar a Lista Ordenada por muito tempo.
-
-    for (int n : tamanhos) {
-        ListaOrdenada* lista = new ListaOrdenada();
-        ArvoreBalanceada* arvore = new ArvoreBalanceada();
-
-        runBenchmark(lista, n);
-        runBenchmark(arvore, n);
-
-        delete lista;
-        delete arvore;
-    }
-
-    return 0;
-}
\ No newline at end of file
+#include <iostream>
+#include <vector>
+#include <set>
+#include <map>
+#include <memory>
+#include <algorithm> // para sort, lower_bound
+#include <iterator>
+#include <chrono>    // para medir o tempo
+#include <cmath>     // para infinity
+#include <iomanip>
+#include <string>
+
+#include "Resultados.h" // Saída JSON/CSV dos resultados
+#include "Varredura.h"  // Varredura de escala com ajuste de complexidade
+#include "Memoria.h"    // Contagem de memória por backend
+
+using namespace std;
+
+// --- Interface Abstrata (Define o que todo "Banco de Sensores" deve ter) ---
+class SensorDatabase {
+public:
+    virtual void insert(double value) = 0;
+    virtual void remove(double value) = 0;
+    virtual void printSorted() = 0;
+    virtual void getMinMax(int k) = 0; // Ex: 3 menores e 3 maiores
+    virtual void rangeQuery(double minVal, double maxVal) = 0;
+    virtual double median() = 0;
+    virtual size_t size() = 0;
+    virtual double minValue() = 0; // Menor leitura (0.0 se vazio)
+    virtual double maxValue() = 0; // Maior leitura (0.0 se vazio)
+    virtual vector<double> minK(int k) = 0; // K menores, em ordem crescente
+    virtual vector<double> maxK(int k) = 0; // K maiores, em ordem decrescente
+    virtual string getName() = 0; // Para identificar nos testes
+    virtual ~SensorDatabase() {}
+
+    // Todas as leituras em ordem crescente (ex: gravar snapshot)
+    virtual vector<double> sortedValues() { return minK((int)size()); }
+    // Acrescenta leituras já ordenadas (ex: restaurar snapshot). Padrão: uma a uma.
+    virtual void bulkLoad(const vector<double>& sorted) {
+        for (double v : sorted) insert(v);
+    }
+
+    // Bytes vivos, pico e número de alocações feitas pelo backend (via insert/remove)
+    UsoMemoria memoryUsage() const { return memoria.uso(); }
+
+protected:
+    // Implementações abrem um EscopoMemoria(memoria) nas operações que alocam
+    ContadorMemoria memoria;
+};
+
+// --- IMPLEMENTAÇÃO 1: Versão Básica (Lista Ordenada / Insertion Sort) ---
+// Inserção lenta O(N), Leitura rápida O(1)
+class ListaOrdenada : public SensorDatabase {
+private:
+    vector<double> dados;
+
+public:
+    string getName() override { return "Versao Basica (Vector)"; }
+
+    void insert(double value) override {
+        EscopoMemoria escopo(memoria);
+        // Encontra a posição correta para manter ordenado (Busca Binária)
+        auto it = lower_bound(dados.begin(), dados.end(), value);
+        // Insere o valor (Isso é LENTO pois desloca todos os elementos à frente)
+        dados.insert(it, value);
+    }
+
+    void remove(double value) override {
+        auto it = lower_bound(dados.begin(), dados.end(), value);
+        if (it != dados.end() && *it == value) {
+            dados.erase(it); // Também lento, desloca elementos
+        }
+    }
+
+    void printSorted() override {
+        // Já está ordenado
+        // for (double v : dados) cout << v << " "; cout << endl; // Comentado para não poluir testes grandes
+    }
+
+    void getMinMax(int k) override {
+        if (dados.empty()) return;
+        int n = dados.size();
+        k = min(k, n);
+        
+        // Acesso direto O(1)
+        // cout << "Minimos: ";
+        // for(int i=0; i<k; i++) cout << dados[i] << " ";
+        // cout << " | Maximos: ";
+        // for(int i=0; i<k; i++) cout << dados[n-1-i] << " ";
+        // cout << endl;
+    }
+
+    void rangeQuery(double minVal, double maxVal) override {
+        auto itStart = lower_bound(dados.begin(), dados.end(), minVal);
+        auto itEnd = upper_bound(dados.begin(), dados.end(), maxVal);
+        
+        // Apenas itera sobre os elementos no intervalo
+        int count = 0;
+        for (auto it = itStart; it != itEnd; ++it) {
+            count++; // Apenas contando para teste de performance
+        }
+        naoOtimizar(count); // Sem isso o compilador elimina o laço inteiro
+    }
+
+    size_t size() override { return dados.size(); }
+
+    vector<double> sortedValues() override { return dados; }
+
+    // O(N): concatena e intercala com o que já existia
+    void bulkLoad(const vector<double>& sorted) override {
+        EscopoMemoria escopo(memoria);
+        size_t meio = dados.size();
+        dados.insert(dados.end(), sorted.begin(), sorted.end());
+        inplace_merge(dados.begin(), dados.begin() + meio, dados.end());
+    }
+
+    // Extremos em O(1): primeiro e último do vetor ordenado
+    double minValue() override { return dados.empty() ? 0.0 : dados.front(); }
+    double maxValue() override { return dados.empty() ? 0.0 : dados.back(); }
+
+    // K extremos em O(K): fatias das pontas do vetor
+    vector<double> minK(int k) override {
+        k = max(0, min(k, (int)dados.size()));
+        return vector<double>(dados.begin(), dados.begin() + k);
+    }
+
+    vector<double> maxK(int k) override {
+        k = max(0, min(k, (int)dados.size()));
+        return vector<double>(dados.rbegin(), dados.rbegin() + k);
+    }
+
+    double median() override {
+        if (dados.empty()) return 0.0;
+        if (dados.size() % 2 == 0) {
+            return (dados[dados.size()/2 - 1] + dados[dados.size()/2]) / 2.0;
+        } else {
+            return dados[dados.size()/2];
+        }
+    }
+};
+
+// --- IMPLEMENTAÇÃO 2: Versão Aprimorada (Árvore Balanceada) ---
+// Inserção rápida O(log N), Remoção rápida O(log N)
+class ArvoreBalanceada : public SensorDatabase {
+private:
+    // multiset permite valores duplicados e mantém ordenação automática (Árvore Rubro-Negra)
+    multiset<double> dados; 
+
+public:
+    string getName() override { return "Versao Aprimorada (Tree/Multiset)"; }
+
+    void insert(double value) override {
+        EscopoMemoria escopo(memoria);
+        dados.insert(value); // O(log N) - Muito mais rápido
+    }
+
+    void remove(double value) override {
+        auto it = dados.find(value);
+        if (it != dados.end()) {
+            dados.erase(it); // O(log N)
+        }
+    }
+
+    void printSorted() override {
+        // Em-ordem (in-order traversal) implícito
+        // for (double v : dados) cout << v << " "; cout << endl;
+    }
+
+    void getMinMax(int k) override {
+        if (dados.empty()) return;
+        int n = dados.size();
+        k = min(k, n);
+
+        // Iteradores bidirecionais
+        // auto it = dados.begin();
+        // cout << "Minimos: ";
+        // for(int i=0; i<k; i++) cout << *it++ << " ";
+        
+        // auto rit = dados.rbegin();
+        // cout << " | Maximos: ";
+        // for(int i=0; i<k; i++) cout << *rit++ << " ";
+        // cout << endl;
+    }
+
+    void rangeQuery(double minVal, double maxVal) override {
+        // Busca o início e fim do intervalo em O(log N)
+        auto itStart = dados.lower_bound(minVal);
+        auto itEnd = dados.upper_bound(maxVal);
+
+        int count = 0;
+        for (auto it = itStart; it != itEnd; ++it) {
+            count++;
+        }
+        naoOtimizar(count);
+    }
+
+    size_t size() override { return dados.size(); }
+
+    vector<double> sortedValues() override { return vector<double>(dados.begin(), dados.end()); }
+
+    // Inserção com dica no fim: O(1) amortizado por leitura quando a entrada é crescente
+    void bulkLoad(const vector<double>& sorted) override {
+        EscopoMemoria escopo(memoria);
+        for (double v : sorted) dados.insert(dados.end(), v);
+    }
+
+    // Extremos em O(1): begin() e rbegin() do multiset
+    double minValue() override { return dados.empty() ? 0.0 : *dados.begin(); }
+    double maxValue() override { return dados.empty() ? 0.0 : *dados.rbegin(); }
+
+    // K extremos em O(K): iteradores bidirecionais a partir das pontas
+    vector<double> minK(int k) override {
+        vector<double> out;
+        for (auto it = dados.begin(); it != dados.end() && (int)out.size() < k; ++it) out.push_back(*it);
+        return out;
+    }
+
+    vector<double> maxK(int k) override {
+        vector<double> out;
+        for (auto it = dados.rbegin(); it != dados.rend() && (int)out.size() < k; ++it) out.push_back(*it);
+        return out;
+    }
+
+    double median() override {
+        if (dados.empty()) return 0.0;
+        size_t size = dados.size();
+        auto it = dados.begin();
+        
+        // Ponto de atenção: Em std::multiset, chegar ao meio custa O(N/2)
+        // Para O(log N) real, seria necessário implementar uma AVL manual com contagem de nós.
+        // Mas para este exercício, a vantagem na inserção compensa.
+        std::advance(it, size / 2);
+        
+        if (size % 2 != 0) {
+            return *it;
+        } else {
+            double val1 = *it;
+            std::advance(it, -1); // volta um
+            double val2 = *it;
+            return (val1 + val2) / 2.0;
+        }
+    }
+};
+
+// Medição única convertida para o formato de resultados (sem dispersão)
+Estatisticas medicaoUnica(double nsPorOp) {
+    Estatisticas e;
+    e.minimo = e.mediana = e.p95 = e.media = nsPorOp;
+    e.icInferior = e.icSuperior = nsPorOp;
+    e.amostras = 1;
+    e.iteracoesPorAmostra = 1;
+    return e;
+}
+
+// --- FUNÇÃO AUXILIAR PARA TESTE DE PERFORMANCE ---
+// Se 'resultados' for informado, cada medição também é registrada (ns/op).
+void runBenchmark(SensorDatabase* db, int dataSize, vector<ResultadoBenchmark>* resultados = nullptr) {
+    // Gerar dados aleatórios
+    vector<double> inputData;
+    inputData.reserve(dataSize);
+    for(int i=0; i<dataSize; i++) {
+        inputData.push_back((rand() % 10000) / 10.0); // Temps entre 0.0 e 1000.0
+    }
+
+    cout << "--- Testando " << db->getName() << " com " << dataSize << " elementos ---" << endl;
+
+    // 1. Medir Tempo de Inserção
+    auto start = chrono::high_resolution_clock::now();
+    for (double v : inputData) {
+        db->insert(v);
+    }
+    auto end = chrono::high_resolution_clock::now();
+    chrono::duration<double> diff = end - start;
+    cout << "Insercao: " << fixed << setprecision(4) << diff.count() << " s" << endl;
+    UsoMemoria uso = db->memoryUsage();
+    double bytesPorElemento = dataSize ? (double)uso.bytesVivos / dataSize : 0.0;
+    cout << "Memoria: " << setprecision(1) << bytesPorElemento << " bytes/elemento (pico "
+         << uso.bytesPico / 1024.0 << " KB, " << uso.alocacoes << " alocacoes)" << setprecision(4) << endl;
+    if (resultados)
+        resultados->push_back(criarResultado(db->getName(), "insercao", dataSize, "uniforme",
+                                             medicaoUnica(diff.count() * 1e9 / dataSize), bytesPorElemento));
+
+    // 2. Medir Range Query (Consulta)
+    start = chrono::high_resolution_clock::now();
+    for(int i=0; i<1000; i++) { // Executa 1000 consultas
+        db->rangeQuery(200.0, 500.0); 
+    }
+    end = chrono::high_resolution_clock::now();
+    diff = end - start;
+    cout << "1000 Consultas (Range): " << diff.count() << " s" << endl;
+    if (resultados)
+        resultados->push_back(criarResultado(db->getName(), "busca_faixa", dataSize, "uniforme",
+                                             medicaoUnica(diff.count() * 1e9 / 1000)));
+
+    // 3. Medir Mediana
+    start = chrono::high_resolution_clock::now();
+    naoOtimizar(db->median()); // para o compilador não otimizar
+    end = chrono::high_resolution_clock::now();
+    diff = end - start;
+    cout << "Calculo da Mediana: " << diff.count() << " s" << endl;
+    if (resultados)
+        resultados->push_back(criarResultado(db->getName(), "mediana", dataSize, "uniforme",
+                                             medicaoUnica(diff.count() * 1e9)));
+
+    cout << "------------------------------------------------" << endl;
+}
+
+#ifndef SENSOR_SEM_MAIN
+// Complexidades prometidas nos comentários de cada implementação (busca_faixa
+// com K fixo, pois a varredura escolhe faixas com ~100 leituras esperadas)
+map<string, Complexidade> complexidadeDeclarada(const string& nome) {
+    if (nome == "Versao Basica (Vector)")
+        return {{"insercao", Complexidade::ON}, {"mediana", Complexidade::O1},
+                {"busca_faixa", Complexidade::OLogN}, {"remocao", Complexidade::ON}};
+    if (nome == "Versao Aprimorada (Tree/Multiset)")
+        return {{"insercao", Complexidade::OLogN}, {"mediana", Complexidade::ON}, // std::advance: O(N/2)
+                {"busca_faixa", Complexidade::OLogN}, {"remocao", Complexidade::OLogN}};
+    return {};
+}
+
+int main(int argc, char** argv) {
+    // Arquivos de saída opcionais: --json resultados.json / --csv resultados.csv
+    // Modo varredura: --varredura [--n-max N] [--orcamento-s S] [--memoria-mb MB]
+    vector<string> saidas;
+    bool varredura = false;
+    ConfigVarredura cfgVarredura;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        if ((arg == "--json" || arg == "--csv") && temValor) saidas.push_back(argv[++i]);
+        else if (arg == "--varredura") varredura = true;
+        else if (arg == "--n-max" && temValor) cfgVarredura.nMax = atoll(argv[++i]);
+        else if (arg == "--orcamento-s" && temValor) cfgVarredura.orcamentoS = atof(argv[++i]);
+        else if (arg == "--memoria-mb" && temValor) cfgVarredura.memoriaMaxMB = atof(argv[++i]);
+    }
+    vector<ResultadoBenchmark> resultados;
+
+    if (varredura) {
+        varrerBackend("Versao Basica (Vector)", []() { return make_unique<ListaOrdenada>(); },
+                      complexidadeDeclarada("Versao Basica (Vector)"), cfgVarredura, &resultados);
+        varrerBackend("Versao Aprimorada (Tree/Multiset)", []() { return make_unique<ArvoreBalanceada>(); },
+                      complexidadeDeclarada("Versao Aprimorada (Tree/Multiset)"), cfgVarredura, &resultados);
+        for (const string& caminho : saidas) {
+            if (!salvarResultados(caminho, resultados)) return 1;
+            cout << "Resultados salvos em '" << caminho << "'." << endl;
+        }
+        return 0;
+    }
+
+    // Configura semente aleatória
+    srand(time(0));
+
+    // Define tamanhos de teste: Pequeno, Médio, Grande
+    vector<int> tamanhos = {1000, 10000, 50000}; 
+    // OBS: 50.000 na lista ordenada já vai demorar alguns segundos.
+    // 100.000 ou mais pode travar a Lista Ordenada por muito tempo.
+    // Para N maiores use --varredura, que pula o que estouraria o orçamento.
+
+    for (int n : tamanhos) {
+        ListaOrdenada* lista = new ListaOrdenada();
+        ArvoreBalanceada* arvore = new ArvoreBalanceada();
+
+        runBenchmark(lista, n, &resultados);
+        runBenchmark(arvore, n, &resultados);
+
+        delete lista;
+        delete arvore;
+    }
+
+    for (const string& caminho : saidas) {
+        if (!salvarResultados(caminho, resultados)) return 1;
+        cout << "Resultados salvos em '" << caminho << "'." << endl;
+    }
+
+    return 0;
+}
+#endif
@@ -0,0 +1,139 @@
+#ifndef CONTADORES_HARDWARE_H
+#define CONTADORES_HARDWARE_H
+
+// Contadores de desempenho do processador via perf_event_open (Linux):
+// ciclos, instruções, misses de L1d/LLC, branch misses e dTLB misses.
+// Cada contador é aberto separadamente: se algum não existir na máquina
+// (VMs, containers, perf_event_paranoid alto), os demais continuam valendo.
+// Fora do Linux, ou sem permissão, tudo aparece como indisponível.
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+enum ContadorHW { HW_CICLOS, HW_INSTRUCOES, HW_L1D_MISS, HW_LLC_MISS, HW_BRANCH_MISS, HW_DTLB_MISS, NUM_CONTADORES_HW };
+
+inline const char* nomeContadorHW(int c) {
+    static const char* nomes[NUM_CONTADORES_HW] = {"ciclos", "instr", "L1d-miss", "LLC-miss", "br-miss", "dTLB-miss"};
+    return nomes[c];
+}
+
+// Valores já divididos pelo número de operações medidas
+struct LeituraContadores {
+    bool disponivel[NUM_CONTADORES_HW] = {};
+    double valor[NUM_CONTADORES_HW] = {};
+
+    bool algumDisponivel() const {
+        for (bool d : disponivel) if (d) return true;
+        return false;
+    }
+};
+
+class ContadoresHardware {
+private:
+    int fds[NUM_CONTADORES_HW];
+    uint64_t acumulado[NUM_CONTADORES_HW] = {};
+    std::string motivoFalha;
+
+#ifdef __linux__
+    static int abrir(uint32_t tipo, uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = tipo;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // Tempos habilitado/rodando: permite corrigir a multiplexação de contadores
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+    }
+
+    static uint64_t cache(uint64_t nivel) {
+        return nivel | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+#endif
+
+public:
+    ContadoresHardware() {
+        for (int& fd : fds) fd = -1;
+#ifdef __linux__
+        fds[HW_CICLOS] = abrir(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        if (fds[HW_CICLOS] < 0) motivoFalha = std::strerror(errno);
+        fds[HW_INSTRUCOES] = abrir(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fds[HW_L1D_MISS] = abrir(PERF_TYPE_HW_CACHE, cache(PERF_COUNT_HW_CACHE_L1D));
+        fds[HW_LLC_MISS] = abrir(PERF_TYPE_HW_CACHE, cache(PERF_COUNT_HW_CACHE_LL));
+        fds[HW_BRANCH_MISS] = abrir(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        fds[HW_DTLB_MISS] = abrir(PERF_TYPE_HW_CACHE, cache(PERF_COUNT_HW_CACHE_DTLB));
+#else
+        motivoFalha = "perf_event_open so existe no Linux";
+#endif
+    }
+
+    ~ContadoresHardware() {
+#ifdef __linux__
+        for (int fd : fds) if (fd >= 0) close(fd);
+#endif
+    }
+
+    ContadoresHardware(const ContadoresHardware&) = delete;
+    ContadoresHardware& operator=(const ContadoresHardware&) = delete;
+
+    bool disponivel() const {
+        for (int fd : fds) if (fd >= 0) return true;
+        return false;
+    }
+
+    // Ex: "Permission denied" (perf_event_paranoid) ou "No such file or directory" (VM sem PMU)
+    const std::string& motivoIndisponivel() const { return motivoFalha; }
+
+    void zerar() {
+        for (uint64_t& a : acumulado) a = 0;
+    }
+
+    // Liga os contadores (chamar imediatamente antes do trecho medido)
+    void iniciar() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Desliga e acumula (chamar imediatamente depois do trecho medido)
+    void parar() {
+#ifdef __linux__
+        for (int fd : fds) if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        for (int c = 0; c < NUM_CONTADORES_HW; c++) {
+            if (fds[c] < 0) continue;
+            uint64_t dados[3]; // valor, tempo habilitado, tempo rodando
+            if (read(fds[c], dados, sizeof(dados)) != (ssize_t)sizeof(dados)) continue;
+            double escala = (dados[2] > 0 && dados[2] < dados[1]) ? (double)dados[1] / dados[2] : 1.0;
+            acumulado[c] += (uint64_t)(dados[0] * escala);
+        }
+#endif
+    }
+
+    // Totais acumulados desde zerar(), divididos por 'operacoes'
+    LeituraContadores porOperacao(double operacoes) const {
+        LeituraContadores l;
+        for (int c = 0; c < NUM_CONTADORES_HW; c++) {
+            l.disponivel[c] = fds[c] >= 0;
+            l.valor[c] = (l.disponivel[c] && operacoes > 0) ? acumulado[c] / operacoes : 0.0;
+        }
+        return l;
+    }
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef HISTOGRAMA_H
+#define HISTOGRAMA_H
+
+// Histograma de latência no estilo HDR: buckets log-lineares com 64 sub-buckets
+// por potência de 2 (erro relativo <= ~1.6%), de 1 ns até ~2^63 ns, em memória fixa.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+class HistogramaLatencia {
+private:
+    static const int BITS_SUB = 6;
+    static const int SUB = 1 << BITS_SUB; // Sub-buckets por potência de 2
+    static const int TOTAL_BUCKETS = (64 - BITS_SUB + 1) * SUB;
+
+    std::vector<uint64_t> contagens;
+    uint64_t total = 0;
+    uint64_t minimo = UINT64_MAX, maximo = 0;
+    double soma = 0;
+
+    // Valores < 64 têm bucket próprio; acima disso usa os 7 bits mais altos
+    static int indice(uint64_t v) {
+        if (v < (uint64_t)SUB) return (int)v;
+        int expoente = 63 - __builtin_clzll(v);
+        int deslocamento = expoente - BITS_SUB;
+        int topo = (int)(v >> deslocamento); // Em [SUB, 2*SUB)
+        return (deslocamento + 1) * SUB + (topo - SUB);
+    }
+
+    static uint64_t limiteSuperior(int idx) {
+        if (idx < SUB) return idx;
+        int deslocamento = idx / SUB - 1;
+        uint64_t topo = (uint64_t)(idx % SUB + SUB);
+        return (topo << deslocamento) + ((1ULL << deslocamento) - 1);
+    }
+
+public:
+    HistogramaLatencia() : contagens(TOTAL_BUCKETS, 0) {}
+
+    void registrar(uint64_t ns) {
+        contagens[indice(ns)]++;
+        total++;
+        soma += (double)ns;
+        minimo = std::min(minimo, ns);
+        maximo = std::max(maximo, ns);
+    }
+
+    // Agrega outro histograma (ex: um por thread)
+    void somar(const HistogramaLatencia& outro) {
+        for (int i = 0; i < TOTAL_BUCKETS; i++) contagens[i] += outro.contagens[i];
+        total += outro.total;
+        soma += outro.soma;
+        minimo = std::min(minimo, outro.minimo);
+        maximo = std::max(maximo, outro.maximo);
+    }
+
+    void limpar() {
+        std::fill(contagens.begin(), contagens.end(), 0);
+        total = 0;
+        soma = 0;
+        minimo = UINT64_MAX;
+        maximo = 0;
+    }
+
+    uint64_t quantidade() const { return total; }
+    uint64_t valorMinimo() const { return total ? minimo : 0; }
+    uint64_t valorMaximo() const { return maximo; }
+    double media() const { return total ? soma / total : 0.0; }
+
+    // Percentil p em [0, 100]: limite superior do bucket que contém a posição
+    uint64_t percentil(double p) const {
+        if (total == 0) return 0;
+        uint64_t alvo = (uint64_t)std::ceil(p / 100.0 * total);
+        if (alvo == 0) alvo = 1;
+        uint64_t acumulado = 0;
+        for (int i = 0; i < TOTAL_BUCKETS; i++) {
+            acumulado += contagens[i];
+            if (acumulado >= alvo) return std::min(limiteSuperior(i), maximo);
+        }
+        return maximo;
+    }
+};
+
+#endif
@@ -0,0 +1,336 @@
+// Driver de ingestão contínua: lê leituras de stdin ou de um pipe nomeado (FIFO),
+// alimenta o backend escolhido e emite estatísticas periódicas.
+//
+// Uso:
+//   ./ingestao [opcoes] [arquivo|-]
+//     --backend NOME     lista | heap | avl | rb | vetor | multiset | pbds (padrao: avl)
+//     --janela N         mantem so as ultimas N leituras (padrao: 100000)
+//     --retencao DUR     mantem so as leituras dos ultimos DUR (ex: 24h); substitui --janela
+//     --mediana-em DUR   com --retencao, emite tambem a mediana dos ultimos DUR (pode repetir)
+//     --a-cada N         emite estatisticas a cada N leituras (padrao: 10000)
+//     --intervalo-ms T   emite tambem a cada T ms, mesmo sem dados (padrao: 1000)
+//     --faixa A:B        conta leituras da janela em [A, B] (pode repetir)
+//
+// Linhas: "valor" ou "instante,valor" (instante em segundos, crescente). Sem
+// instante, vale o tempo desde o início da ingestão.
+//
+// Exemplo com FIFO:
+//   mkfifo /tmp/sensor && ./ingestao --backend avl --faixa 20:30 /tmp/sensor
+//   (em outro terminal) cat temperaturas.csv > /tmp/sensor
+//
+// Exemplo com retenção: ./ingestao --retencao 24h --mediana-em 1h leituras_com_instante.csv
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "Adaptadores dos sensores.h"
+#include "JanelaTemporal.h"
+
+using Relogio = chrono::steady_clock;
+
+struct Faixa {
+    double minVal, maxVal;
+    size_t contagem = 0; // Leituras da janela dentro da faixa
+};
+
+struct Configuracao {
+    string backend = "avl";
+    size_t janela = 100000;
+    double retencaoS = 0;                               // > 0: janela por tempo
+    vector<pair<string, double>> medianasEm;            // Sub-janelas: (rótulo, segundos)
+    size_t aCada = 10000;
+    long intervaloMs = 1000;
+    vector<Faixa> faixas;
+    string entrada = "-";
+};
+
+// --- Janela circular de tamanho fixo (memória limitada) ---
+// Guarda a ordem de chegada para saber qual leitura sai do backend quando a janela enche.
+class JanelaCircular {
+private:
+    vector<double> buffer;
+    size_t inicio = 0, quantidade = 0;
+
+public:
+    JanelaCircular(size_t capacidade) : buffer(capacidade) {}
+
+    bool cheia() const { return quantidade == buffer.size(); }
+
+    // Insere no fim; se cheia, devolve em 'removido' a leitura mais antiga
+    bool empurrar(double valor, double& removido) {
+        if (cheia()) {
+            removido = buffer[inicio];
+            buffer[inicio] = valor;
+            inicio = (inicio + 1) % buffer.size();
+            return true;
+        }
+        buffer[(inicio + quantidade) % buffer.size()] = valor;
+        quantidade++;
+        return false;
+    }
+};
+
+class IngestaoContinua {
+private:
+    Configuracao cfg;
+    unique_ptr<SensorDatabase> db;       // Modo por contagem (--janela)
+    JanelaCircular janela;
+    unique_ptr<JanelaTemporal> temporal; // Modo por tempo (--retencao)
+    SensorDatabase* indice;              // Índice por valor consultado nas emissões
+
+    size_t lidas = 0, descartadas = 0;
+    size_t lidasNaUltimaEmissao = 0;
+    Relogio::time_point inicio, ultimaEmissao;
+
+    void contarFaixas(double valor, int delta) {
+        for (Faixa& f : cfg.faixas) {
+            if (valor >= f.minVal && valor <= f.maxVal) f.contagem += delta;
+        }
+    }
+
+public:
+    IngestaoContinua(const Configuracao& c, const EntradaBackend& backend)
+        : cfg(c), janela(c.retencaoS > 0 ? 0 : c.janela) {
+        if (cfg.retencaoS > 0) {
+            // Índices criados sob demanda (retenção + uma sub-janela por --mediana-em)
+            temporal = make_unique<JanelaTemporal>(cfg.retencaoS, backend.criar);
+            temporal->definirAoExpirar([this](const LeituraTemporal& l) { contarFaixas(l.valor, -1); });
+            for (const auto& m : cfg.medianasEm) temporal->adicionarJanela(m.second);
+            indice = &temporal->indice();
+        } else {
+            db = backend.criar();
+            indice = db.get();
+        }
+        inicio = ultimaEmissao = Relogio::now();
+    }
+
+    void processarLinha(const char* linha) {
+        char* fim = nullptr;
+        double valor = strtod(linha, &fim);
+        if (fim == linha) { // Linha vazia ou inválida (ex: cabeçalho)
+            descartadas++;
+            return;
+        }
+
+        // "instante,valor": o primeiro número era o instante
+        double instante = chrono::duration<double>(Relogio::now() - inicio).count();
+        while (*fim == ' ' || *fim == '\t') fim++;
+        if (*fim == ',' || *fim == ';') {
+            const char* resto = fim + 1;
+            char* fimValor = nullptr;
+            double v = strtod(resto, &fimValor);
+            if (fimValor == resto) {
+                descartadas++;
+                return;
+            }
+            instante = valor;
+            valor = v;
+        }
+
+        if (temporal) {
+            // A expiração (e o ajuste das faixas) acontece dentro do inserir
+            if (!temporal->inserir(instante, valor)) return;
+        } else {
+            double removido;
+            if (janela.empurrar(valor, removido)) {
+                db->remove(removido);
+                contarFaixas(removido, -1);
+            }
+            db->insert(valor);
+        }
+        contarFaixas(valor, +1);
+        lidas++;
+
+        if (lidas - lidasNaUltimaEmissao >= cfg.aCada) emitir();
+    }
+
+    // Milissegundos até a próxima emissão por tempo (usado como timeout do poll)
+    int msAteProximaEmissao() {
+        long decorrido = chrono::duration_cast<chrono::milliseconds>(Relogio::now() - ultimaEmissao).count();
+        return (int)max(0L, cfg.intervaloMs - decorrido);
+    }
+
+    void emitir() {
+        auto agora = Relogio::now();
+        double total = chrono::duration<double>(agora - inicio).count();
+        double parcial = chrono::duration<double>(agora - ultimaEmissao).count();
+        size_t novas = lidas - lidasNaUltimaEmissao;
+
+        cout << fixed << setprecision(3)
+             << "[t=" << setw(8) << total << "s] lidas=" << lidas
+             << " janela=" << indice->size()
+             << setprecision(2)
+             << " mediana=" << indice->median()
+             << " min=" << indice->minValue()
+             << " max=" << indice->maxValue();
+        if (temporal) {
+            for (size_t i = 0; i < cfg.medianasEm.size(); i++)
+                cout << " mediana[" << cfg.medianasEm[i].first << "]=" << temporal->medianaJanela(i);
+        }
+        for (const Faixa& f : cfg.faixas) {
+            cout << " [" << f.minVal << ":" << f.maxVal << "]=" << f.contagem;
+        }
+        cout << setprecision(0)
+             << " taxa=" << (parcial > 0 ? novas / parcial : 0.0) << " leit/s"
+             << endl;
+
+        ultimaEmissao = agora;
+        lidasNaUltimaEmissao = lidas;
+    }
+
+    void resumoFinal() {
+        double total = chrono::duration<double>(Relogio::now() - inicio).count();
+        cout << "--- Resumo (" << indice->getName() << ") ---" << endl;
+        cout << "Leituras aceitas: " << lidas << " | descartadas: " << descartadas;
+        if (temporal) cout << " | fora de ordem: " << temporal->leiturasRecusadas();
+        cout << endl;
+        cout << fixed << setprecision(3) << "Tempo total: " << total << " s" << endl;
+        cout << setprecision(0) << "Taxa sustentada: " << (total > 0 ? lidas / total : 0.0) << " leituras/s" << endl;
+    }
+
+    bool temEmissaoPendente() const { return lidas != lidasNaUltimaEmissao; }
+};
+
+// Lê o descritor em blocos e separa as linhas. O poll() com timeout garante
+// a emissão periódica por tempo mesmo quando o produtor fica em silêncio.
+int executar(int fd, IngestaoContinua& ingestao) {
+    const size_t MAX_LINHA = 4096; // Linhas maiores são descartadas (memória limitada)
+    vector<char> bloco(1 << 16);
+    string pendente;
+    bool descartandoLinha = false;
+
+    while (true) {
+        pollfd pfd = {fd, POLLIN, 0};
+        int pronto = poll(&pfd, 1, ingestao.msAteProximaEmissao());
+        if (pronto < 0) {
+            if (errno == EINTR) continue;
+            perror("poll");
+            return 1;
+        }
+        if (pronto == 0) { // Timeout: hora de emitir
+            ingestao.emitir();
+            continue;
+        }
+
+        ssize_t lidos = read(fd, bloco.data(), bloco.size());
+        if (lidos < 0) {
+            if (errno == EINTR || errno == EAGAIN) continue;
+            perror("read");
+            return 1;
+        }
+        if (lidos == 0) break; // EOF (escritor fechou o pipe)
+
+        for (ssize_t i = 0; i < lidos; i++) {
+            char c = bloco[i];
+            if (c == '\n') {
+                if (!descartandoLinha) ingestao.processarLinha(pendente.c_str());
+                pendente.clear();
+                descartandoLinha = false;
+            } else if (!descartandoLinha) {
+                pendente.push_back(c);
+                if (pendente.size() > MAX_LINHA) {
+                    pendente.clear();
+                    descartandoLinha = true;
+                }
+            }
+        }
+        if (ingestao.msAteProximaEmissao() == 0) ingestao.emitir();
+    }
+
+    if (!pendente.empty() && !descartandoLinha) ingestao.processarLinha(pendente.c_str());
+    if (ingestao.temEmissaoPendente()) ingestao.emitir();
+    ingestao.resumoFinal();
+    return 0;
+}
+
+void imprimirUso() {
+    cerr << "Uso: ingestao [--backend NOME] [--janela N | --retencao DUR [--mediana-em DUR]...]"
+         << " [--a-cada N] [--intervalo-ms T] [--faixa A:B]... [arquivo|-]" << endl;
+    cerr << "DUR: segundos ou com sufixo s/m/h/d (ex: 24h)" << endl;
+    cerr << "Backends:";
+    for (const string& b : backendsDisponiveis()) cerr << " " << b;
+    cerr << endl;
+}
+
+int main(int argc, char** argv) {
+    Configuracao cfg;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        if (arg == "--backend" && temValor) cfg.backend = argv[++i];
+        else if (arg == "--janela" && temValor) cfg.janela = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--a-cada" && temValor) cfg.aCada = strtoul(argv[++i], nullptr, 10);
+        else if ((arg == "--retencao" || arg == "--mediana-em") && temValor) {
+            double segundos;
+            if (!lerDuracao(argv[++i], segundos) || segundos <= 0) {
+                cerr << "[ERRO] Duracao invalida: " << argv[i] << endl;
+                return 1;
+            }
+            if (arg == "--retencao") cfg.retencaoS = segundos;
+            else cfg.medianasEm.push_back({argv[i], segundos});
+        }
+        else if (arg == "--intervalo-ms" && temValor) cfg.intervaloMs = strtol(argv[++i], nullptr, 10);
+        else if (arg == "--faixa" && temValor) {
+            Faixa f;
+            if (sscanf(argv[++i], "%lf:%lf", &f.minVal, &f.maxVal) != 2) {
+                cerr << "[ERRO] Faixa invalida: " << argv[i] << endl;
+                return 1;
+            }
+            cfg.faixas.push_back(f);
+        } else if (arg == "-h" || arg == "--help") {
+            imprimirUso();
+            return 0;
+        } else if (arg[0] != '-' || arg == "-") cfg.entrada = arg;
+        else {
+            imprimirUso();
+            return 1;
+        }
+    }
+
+    if (cfg.janela == 0 || cfg.aCada == 0 || cfg.intervaloMs <= 0) {
+        cerr << "[ERRO] --janela, --a-cada e --intervalo-ms devem ser positivos." << endl;
+        return 1;
+    }
+
+    if (!cfg.medianasEm.empty() && cfg.retencaoS <= 0) {
+        cerr << "[ERRO] --mediana-em exige --retencao." << endl;
+        return 1;
+    }
+
+    const EntradaBackend* backend = buscarBackend(cfg.backend);
+    if (!backend) {
+        cerr << "[ERRO] Backend desconhecido: " << cfg.backend << endl;
+        imprimirUso();
+        return 1;
+    }
+
+    int fd = 0; // stdin
+    if (cfg.entrada != "-") {
+        fd = open(cfg.entrada.c_str(), O_RDONLY);
+        if (fd < 0) {
+            cerr << "[ERRO] Nao foi possivel abrir '" << cfg.entrada << "': " << strerror(errno) << endl;
+            return 1;
+        }
+    }
+
+    IngestaoContinua ingestao(cfg, *backend);
+    cerr << ">>> Ingestao continua: backend=" << cfg.backend;
+    if (cfg.retencaoS > 0) cerr << " retencao=" << cfg.retencaoS << "s";
+    else cerr << " janela=" << cfg.janela;
+    cerr << " a-cada=" << cfg.aCada << " intervalo=" << cfg.intervaloMs << "ms" << endl;
+
+
+    int status = executar(fd, ingestao);
+    if (fd != 0) close(fd);
+    return status;
+}
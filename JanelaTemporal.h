@@ -0,0 +1,144 @@
+#ifndef JANELA_TEMPORAL_H
+#define JANELA_TEMPORAL_H
+
+// Leituras com instante (timestamp) e retenção por tempo ("manter as últimas 24 h").
+//
+// A fila de chegada guarda (instante, valor) em ordem de tempo; cada índice por
+// valor (qualquer SensorDatabase: AVL, rubro-negra...) guarda só os valores.
+// Expirar tudo o que é mais antigo que T percorre a frente da fila e remove os
+// mesmos valores do índice: O(k log N) para k leituras expiradas, sem recarga.
+//
+// Sub-janelas ("mediana da última hora") são índices extras com um cursor na
+// fila: o cursor aponta a leitura mais antiga ainda indexada e só avança.
+// Todas compartilham a mesma fila, então nenhuma leitura é copiada.
+//
+// Instantes em segundos (qualquer origem: epoch, tempo desde o boot...).
+// Leituras fora de ordem são recusadas: a fila depende de tempo crescente.
+// Requer SensorDatabase declarado antes (ex: "Adaptadores dos sensores.h").
+
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct LeituraTemporal {
+    double instante;
+    double valor;
+};
+
+// "90", "30s", "15m", "24h", "7d" -> segundos. Devolve false se inválido.
+inline bool lerDuracao(const std::string& texto, double& segundos) {
+    char* fim = nullptr;
+    double v = std::strtod(texto.c_str(), &fim);
+    if (fim == texto.c_str() || v < 0) return false;
+    std::string unidade(fim);
+    if (unidade.empty() || unidade == "s") segundos = v;
+    else if (unidade == "m") segundos = v * 60;
+    else if (unidade == "h") segundos = v * 3600;
+    else if (unidade == "d") segundos = v * 86400;
+    else return false;
+    return true;
+}
+
+class JanelaTemporal {
+public:
+    using Fabrica = std::function<std::unique_ptr<SensorDatabase>()>;
+    using AoExpirar = std::function<void(const LeituraTemporal&)>;
+
+private:
+    struct SubJanela {
+        double duracaoS;
+        std::unique_ptr<SensorDatabase> indice;
+        uint64_t cursor; // Sequência da leitura mais antiga ainda indexada
+    };
+
+    Fabrica criar;
+    double retencaoS;
+    std::deque<LeituraTemporal> chegada;
+    uint64_t seqInicio = 0; // Sequência global de chegada.front()
+    std::unique_ptr<SensorDatabase> retidas;
+    std::vector<SubJanela> janelas;
+    AoExpirar aoExpirar;
+    size_t recusadas = 0;
+
+    const LeituraTemporal& porSequencia(uint64_t seq) const { return chegada[seq - seqInicio]; }
+    uint64_t seqFim() const { return seqInicio + chegada.size(); }
+
+    // Tira do índice da sub-janela tudo com instante < limite
+    static void avancar(SubJanela& j, const JanelaTemporal& dono, double limite) {
+        while (j.cursor < dono.seqFim() && dono.porSequencia(j.cursor).instante < limite) {
+            j.indice->remove(dono.porSequencia(j.cursor).valor);
+            j.cursor++;
+        }
+    }
+
+public:
+    JanelaTemporal(double retencaoSegundos, Fabrica fabrica)
+        : criar(std::move(fabrica)), retencaoS(retencaoSegundos), retidas(criar()) {}
+
+    // Chamado para cada leitura que sai da retenção (ex: manter contadores externos)
+    void definirAoExpirar(AoExpirar f) { aoExpirar = std::move(f); }
+
+    // Nova sub-janela com as leituras dos últimos 'duracaoS' segundos (<= retenção).
+    // Se já houver dados, o índice é preenchido com o trecho correspondente da fila.
+    size_t adicionarJanela(double duracaoS) {
+        SubJanela j{duracaoS < retencaoS ? duracaoS : retencaoS, criar(), seqInicio};
+        if (!chegada.empty()) {
+            double limite = chegada.back().instante - j.duracaoS;
+            while (j.cursor < seqFim() && porSequencia(j.cursor).instante < limite) j.cursor++;
+            for (uint64_t s = j.cursor; s < seqFim(); s++) j.indice->insert(porSequencia(s).valor);
+        }
+        janelas.push_back(std::move(j));
+        return janelas.size() - 1;
+    }
+
+    // Insere e expira o que ficou velho em relação ao novo instante.
+    // Devolve false (e ignora a leitura) se o instante for anterior ao último aceito.
+    bool inserir(double instante, double valor) {
+        if (!chegada.empty() && instante < chegada.back().instante) {
+            recusadas++;
+            return false;
+        }
+        chegada.push_back({instante, valor});
+        retidas->insert(valor);
+        for (SubJanela& j : janelas) j.indice->insert(valor);
+        expirarAntesDe(instante - retencaoS);
+        for (SubJanela& j : janelas) avancar(j, *this, instante - j.duracaoS);
+        return true;
+    }
+
+    // Remoção em lote de tudo com instante < limite (retenção e sub-janelas)
+    size_t expirarAntesDe(double limite) {
+        for (SubJanela& j : janelas) avancar(j, *this, limite);
+        size_t removidas = 0;
+        while (!chegada.empty() && chegada.front().instante < limite) {
+            const LeituraTemporal& l = chegada.front();
+            retidas->remove(l.valor);
+            if (aoExpirar) aoExpirar(l);
+            chegada.pop_front();
+            seqInicio++;
+            removidas++;
+        }
+        return removidas;
+    }
+
+    // Índice por valor de todas as leituras retidas
+    SensorDatabase& indice() { return *retidas; }
+    // Índice por valor da sub-janela 'i' (na ordem de adicionarJanela)
+    SensorDatabase& janela(size_t i) { return *janelas[i].indice; }
+    double duracaoJanela(size_t i) const { return janelas[i].duracaoS; }
+    size_t numJanelas() const { return janelas.size(); }
+
+    double medianaJanela(size_t i) { return janelas[i].indice->median(); }
+
+    size_t quantidade() const { return chegada.size(); }
+    size_t leiturasRecusadas() const { return recusadas; }
+    double retencao() const { return retencaoS; }
+    double instanteMaisAntigo() const { return chegada.empty() ? 0.0 : chegada.front().instante; }
+    double instanteMaisRecente() const { return chegada.empty() ? 0.0 : chegada.back().instante; }
+};
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef MEDICAO_H
+#define MEDICAO_H
+
+// Harness de medição: aquecimento, lote adaptativo, várias amostras e
+// estatísticas robustas (mínimo, mediana, p95, intervalo de confiança).
+// Todos os tempos são em nanossegundos por operação.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "ContadoresHardware.h"
+
+struct ConfigMedicao {
+    int aquecimento = 3;                     // Execuções descartadas antes de medir
+    int amostras = 21;                       // Repetições cronometradas
+    long long alvoNsPorAmostra = 2000000;    // Lote adaptativo: cada amostra dura >= 2 ms
+    long long maxIteracoesPorAmostra = 1LL << 24;
+    ContadoresHardware* contadores = nullptr; // Opcional: contadores de hardware nas amostras
+};
+
+struct Estatisticas {
+    double minimo = 0, mediana = 0, p95 = 0;  // ns/op
+    double media = 0, desvio = 0;             // ns/op (para testes estatísticos)
+    double icInferior = 0, icSuperior = 0;    // IC 95% da mediana (ns/op)
+    int amostras = 0;
+    long long iteracoesPorAmostra = 0;
+    LeituraContadores contadores;             // Por operação (se ConfigMedicao::contadores)
+};
+
+// --- Barreiras contra eliminação de código morto ---
+// O asm vazio "usa" o valor (registrador ou memória), então o compilador
+// não pode descartar a computação que o produziu.
+template <typename T>
+inline void naoOtimizar(T const& valor) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(valor) : "memory");
+#else
+    static volatile const void* sumidouro;
+    sumidouro = &valor;
+#endif
+}
+
+// Impede que o compilador reordene leituras/escritas através deste ponto
+inline void barreiraCompilador() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+inline long long agoraNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Calcula as estatísticas a partir das amostras (ns/op)
+inline Estatisticas resumirAmostras(std::vector<double> ns, long long iteracoes) {
+    Estatisticas e;
+    e.amostras = ns.size();
+    e.iteracoesPorAmostra = iteracoes;
+    if (ns.empty()) return e;
+
+    std::sort(ns.begin(), ns.end());
+    size_t n = ns.size();
+
+    // Percentil por interpolação linear entre as posições vizinhas
+    auto percentil = [&](double p) {
+        double pos = p * (n - 1);
+        size_t i = (size_t)pos;
+        double frac = pos - i;
+        return (i + 1 < n) ? ns[i] * (1 - frac) + ns[i + 1] * frac : ns[i];
+    };
+
+    e.minimo = ns.front();
+    e.mediana = percentil(0.5);
+    e.p95 = percentil(0.95);
+
+    double soma = 0;
+    for (double v : ns) soma += v;
+    e.media = soma / n;
+    double somaQuad = 0;
+    for (double v : ns) somaQuad += (v - e.media) * (v - e.media);
+    e.desvio = n > 1 ? std::sqrt(somaQuad / (n - 1)) : 0.0;
+
+    // IC 95% da mediana sem supor normalidade (estatísticas de ordem):
+    // posições n/2 -+ 1.96 * sqrt(n) / 2 na amostra ordenada.
+    double meiaLargura = 1.96 * std::sqrt((double)n) / 2.0;
+    long inf = (long)std::floor(n / 2.0 - meiaLargura);
+    long sup = (long)std::ceil(n / 2.0 + meiaLargura);
+    e.icInferior = ns[std::max(0L, inf)];
+    e.icSuperior = ns[std::min((long)n - 1, sup)];
+    return e;
+}
+
+// --- Operações repetíveis (não alteram o estado, ex: mediana, busca) ---
+// O lote é dobrado até cada amostra durar pelo menos alvoNsPorAmostra,
+// o que elimina o problema de operações mais rápidas que a resolução do relógio.
+template <typename Func>
+Estatisticas medirRepetivel(Func funcao, const ConfigMedicao& cfg = ConfigMedicao()) {
+    for (int i = 0; i < cfg.aquecimento; i++) naoOtimizar(funcao());
+
+    long long iteracoes = 1;
+    while (true) {
+        long long inicio = agoraNs();
+        for (long long i = 0; i < iteracoes; i++) naoOtimizar(funcao());
+        long long decorrido = agoraNs() - inicio;
+        if (decorrido >= cfg.alvoNsPorAmostra || iteracoes >= cfg.maxIteracoesPorAmostra) break;
+        iteracoes *= 2;
+    }
+
+    // Contadores ligados só durante as amostras (fora do relógio de parede)
+    if (cfg.contadores) cfg.contadores->zerar();
+    std::vector<double> ns;
+    for (int a = 0; a < cfg.amostras; a++) {
+        if (cfg.contadores) cfg.contadores->iniciar();
+        long long inicio = agoraNs();
+        for (long long i = 0; i < iteracoes; i++) naoOtimizar(funcao());
+        long long decorrido = agoraNs() - inicio;
+        if (cfg.contadores) cfg.contadores->parar();
+        ns.push_back((double)decorrido / iteracoes);
+    }
+    Estatisticas e = resumirAmostras(ns, iteracoes);
+    if (cfg.contadores) e.contadores = cfg.contadores->porOperacao((double)cfg.amostras * iteracoes);
+    return e;
+}
+
+// --- Operações que consomem estado (ex: inserir N, remover 100) ---
+// 'preparar' reconstrói o estado antes de cada amostra e fica fora do cronômetro.
+// 'executar' roda uma vez por amostra e processa 'opsPorExecucao' operações.
+template <typename Preparar, typename Executar>
+Estatisticas medirComPreparo(Preparar preparar, Executar executar, long long opsPorExecucao,
+                             const ConfigMedicao& cfg = ConfigMedicao()) {
+    if (opsPorExecucao <= 0) opsPorExecucao = 1;
+    for (int i = 0; i < cfg.aquecimento; i++) {
+        preparar();
+        executar();
+    }
+
+    if (cfg.contadores) cfg.contadores->zerar();
+    std::vector<double> ns;
+    for (int a = 0; a < cfg.amostras; a++) {
+        preparar();
+        barreiraCompilador();
+        if (cfg.contadores) cfg.contadores->iniciar();
+        long long inicio = agoraNs();
+        executar();
+        barreiraCompilador();
+        long long decorrido = agoraNs() - inicio;
+        if (cfg.contadores) cfg.contadores->parar();
+        ns.push_back((double)decorrido / opsPorExecucao);
+    }
+    Estatisticas e = resumirAmostras(ns, 1);
+    if (cfg.contadores) e.contadores = cfg.contadores->porOperacao((double)cfg.amostras * opsPorExecucao);
+    return e;
+}
+
+// Diferença significativa: os intervalos de confiança das medianas não se sobrepõem
+inline bool significativamenteMenor(const Estatisticas& a, const Estatisticas& b) {
+    return a.icSuperior < b.icInferior;
+}
+
+#endif
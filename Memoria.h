@@ -0,0 +1,105 @@
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+// Contabilidade de memória por estrutura: bytes vivos, pico e número de alocações.
+//
+// Funciona como um gancho no alocador: o operator new global é substituído e cada
+// bloco recebe um cabeçalho com o contador "dono". O dono é o ContadorMemoria do
+// EscopoMemoria ativo na thread no momento da alocação; a liberação credita o
+// mesmo contador, esteja ou não dentro de um escopo. Assim nós de árvore, nós de
+// std::multiset e vetores de priority_queue são contados sem trocar seus tipos.
+//
+// Os bytes contabilizados estimam o custo real no glibc (cabeçalho de 8 bytes
+// do malloc, blocos múltiplos de 16, mínimo de 32), não o tamanho pedido.
+// Este header substitui o operator new do programa: inclua em um único .cpp.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+struct UsoMemoria {
+    size_t bytesVivos = 0;
+    size_t bytesPico = 0;
+    size_t alocacoes = 0;  // Total de alocações desde a criação (não só as vivas)
+};
+
+class ContadorMemoria {
+private:
+    std::atomic<size_t> vivos{0}, pico{0}, alocacoes{0};
+
+public:
+    void registrarAlocacao(size_t bytes) {
+        size_t atual = vivos.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        alocacoes.fetch_add(1, std::memory_order_relaxed);
+        size_t p = pico.load(std::memory_order_relaxed);
+        while (atual > p && !pico.compare_exchange_weak(p, atual, std::memory_order_relaxed)) {}
+    }
+
+    void registrarLiberacao(size_t bytes) { vivos.fetch_sub(bytes, std::memory_order_relaxed); }
+
+    UsoMemoria uso() const {
+        UsoMemoria u;
+        u.bytesVivos = vivos.load(std::memory_order_relaxed);
+        u.bytesPico = pico.load(std::memory_order_relaxed);
+        u.alocacoes = alocacoes.load(std::memory_order_relaxed);
+        return u;
+    }
+
+    // Reinicia o pico a partir do uso atual (ex: medir o pico de uma fase)
+    void reiniciarPico() { pico.store(vivos.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+};
+
+inline ContadorMemoria*& contadorAtivo() {
+    static thread_local ContadorMemoria* ativo = nullptr;
+    return ativo;
+}
+
+// Tudo o que for alocado nesta thread enquanto o escopo existir pertence a 'c'.
+// Escopos podem ser aninhados; o mais interno vence.
+class EscopoMemoria {
+private:
+    ContadorMemoria* anterior;
+
+public:
+    explicit EscopoMemoria(ContadorMemoria& c) : anterior(contadorAtivo()) { contadorAtivo() = &c; }
+    ~EscopoMemoria() { contadorAtivo() = anterior; }
+    EscopoMemoria(const EscopoMemoria&) = delete;
+    EscopoMemoria& operator=(const EscopoMemoria&) = delete;
+};
+
+// Custo estimado de um bloco no malloc do glibc
+inline size_t custoAlocacao(size_t pedido) {
+    size_t bloco = (pedido + 8 + 15) & ~(size_t)15;
+    return bloco < 32 ? 32 : bloco;
+}
+
+// --- Substituição do operator new/delete global ---
+// Cabeçalho de 16 bytes (mantém o alinhamento de 16 do malloc)
+struct CabecalhoAlocacao {
+    ContadorMemoria* dono;
+    size_t custo;
+};
+static_assert(sizeof(CabecalhoAlocacao) == 16, "cabecalho deve preservar alinhamento de 16");
+
+// (noinline: evita que o GCC enxergue malloc/free "trocados" ao inlinar nos chamadores)
+__attribute__((noinline)) void* operator new(std::size_t tam) {
+    void* bruto = std::malloc(sizeof(CabecalhoAlocacao) + tam);
+    if (!bruto) throw std::bad_alloc();
+    CabecalhoAlocacao* cab = static_cast<CabecalhoAlocacao*>(bruto);
+    cab->dono = contadorAtivo();
+    cab->custo = custoAlocacao(tam);
+    if (cab->dono) cab->dono->registrarAlocacao(cab->custo);
+    return cab + 1;
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    if (!p) return;
+    CabecalhoAlocacao* cab = static_cast<CabecalhoAlocacao*>(p) - 1;
+    if (cab->dono) cab->dono->registrarLiberacao(cab->custo);
+    std::free(cab);
+}
+
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+
+#endif
@@ -0,0 +1,346 @@
+#ifndef PERSISTENCIA_H
+#define PERSISTENCIA_H
+
+// Persistência à prova de queda para qualquer SensorDatabase.
+//
+// BancoPersistente decora um backend:
+//  - WAL (write-ahead log): cada insert/remove vira um registro com LSN e CRC32
+//    anexado a <dir>/wal.log. A confirmação é em grupo: o fdatasync acontece a
+//    cada 'grupo' operações ou 'intervaloMs', o que vier primeiro (grupo = 1 é
+//    durável por operação; com grupo > 1 uma queda perde no máximo o grupo aberto).
+//  - Snapshot: <dir>/snapshot.bin guarda as leituras em ordem crescente e o LSN
+//    que cobre. É escrito em arquivo temporário + fsync + rename (atômico); só
+//    depois o WAL é truncado. Uma queda no meio deixa o snapshot antigo ou o novo.
+//  - Recuperação: carrega o snapshot com bulkLoad (ordenado, O(N) nos backends que
+//    suportam) e reaplica só os registros do WAL com LSN maior. Um registro final
+//    incompleto ou com CRC inválido (escrita rasgada) é descartado e o WAL é
+//    truncado nesse ponto.
+//
+// Requer SensorDatabase declarado antes (ex: "Adaptadores dos sensores.h").
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Medicao.h"
+
+// CRC32 (IEEE 802.3, polinômio refletido 0xEDB88320)
+inline uint32_t crc32(const void* dados, size_t tam, uint32_t crc = 0) {
+    static uint32_t tabela[256];
+    static bool pronta = false;
+    if (!pronta) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            tabela[i] = c;
+        }
+        pronta = true;
+    }
+    const unsigned char* p = static_cast<const unsigned char*>(dados);
+    crc = ~crc;
+    for (size_t i = 0; i < tam; i++) crc = tabela[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+struct ConfigPersistencia {
+    std::string diretorio = "dados_sensor";
+    size_t grupo = 64;          // Operações por fdatasync (1 = durável por operação)
+    long intervaloMs = 10;      // Tempo máximo que uma operação espera pelo fdatasync
+    size_t snapshotACada = 0;   // Snapshot automático a cada N operações (0 = só manual)
+};
+
+struct RelatorioRecuperacao {
+    bool snapshotValido = false;
+    uint64_t lsnSnapshot = 0;
+    size_t leiturasSnapshot = 0;
+    size_t opsReaplicadas = 0;
+    size_t bytesDescartados = 0; // Cauda rasgada do WAL
+    double msSnapshot = 0, msWal = 0;
+};
+
+struct EstatisticasPersistencia {
+    size_t operacoes = 0;
+    size_t fsyncs = 0;
+    long long nsEmFsync = 0;  // Tempo total dentro de write + fdatasync do WAL
+    size_t snapshots = 0;
+    long long nsEmSnapshot = 0;
+};
+
+class BancoPersistente : public SensorDatabase {
+private:
+    // Registro do WAL: lsn (8) | tipo (1) | valor (8) | crc32 dos 17 bytes anteriores (4)
+    static const size_t TAM_REGISTRO = 21;
+    static const unsigned char OP_INSERT = 1, OP_REMOVE = 2;
+    static constexpr const char* MAGICO_SNAPSHOT = "SNP1";
+
+    std::unique_ptr<SensorDatabase> db;
+    ConfigPersistencia cfg;
+    int fdWal = -1;
+    uint64_t proximoLsn = 1;
+    std::vector<unsigned char> pendente; // Registros ainda não sincronizados
+    size_t opsPendentes = 0;
+    long long inicioGrupoNs = 0;
+    size_t opsDesdeSnapshot = 0;
+    EstatisticasPersistencia stats;
+    bool falhou = false;
+
+    std::string caminho(const char* nome) const { return cfg.diretorio + "/" + nome; }
+
+    void registrarFalha(const std::string& oQue) {
+        if (!falhou) std::cerr << "[ERRO] Persistencia: " << oQue << ": " << std::strerror(errno) << std::endl;
+        falhou = true;
+    }
+
+    static bool escreverTudo(int fd, const void* dados, size_t tam) {
+        const char* p = static_cast<const char*>(dados);
+        while (tam > 0) {
+            ssize_t n = ::write(fd, p, tam);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            p += n;
+            tam -= n;
+        }
+        return true;
+    }
+
+    static bool lerArquivo(const std::string& path, std::vector<unsigned char>& out) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        out.resize(st.st_size);
+        size_t lidos = 0;
+        while (lidos < out.size()) {
+            ssize_t n = ::read(fd, out.data() + lidos, out.size() - lidos);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            lidos += n;
+        }
+        ::close(fd);
+        out.resize(lidos);
+        return true;
+    }
+
+    // fsync do diretório: torna o rename/criação de arquivos durável
+    void sincronizarDiretorio() {
+        int fd = ::open(cfg.diretorio.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd >= 0) {
+            ::fsync(fd);
+            ::close(fd);
+        }
+    }
+
+    void registrar(unsigned char tipo, double valor) {
+        unsigned char reg[TAM_REGISTRO];
+        uint64_t lsn = proximoLsn++;
+        std::memcpy(reg, &lsn, 8);
+        reg[8] = tipo;
+        std::memcpy(reg + 9, &valor, 8);
+        uint32_t crc = crc32(reg, 17);
+        std::memcpy(reg + 17, &crc, 4);
+
+        if (opsPendentes == 0) inicioGrupoNs = agoraNs();
+        pendente.insert(pendente.end(), reg, reg + TAM_REGISTRO);
+        opsPendentes++;
+        stats.operacoes++;
+        opsDesdeSnapshot++;
+
+        if (opsPendentes >= cfg.grupo || agoraNs() - inicioGrupoNs >= cfg.intervaloMs * 1000000LL) sincronizar();
+        if (cfg.snapshotACada > 0 && opsDesdeSnapshot >= cfg.snapshotACada) snapshot();
+    }
+
+    // Carrega o snapshot (se houver e for válido) no backend
+    void carregarSnapshot(RelatorioRecuperacao& rel) {
+        long long t0 = agoraNs();
+        std::vector<unsigned char> bytes;
+        if (lerArquivo(caminho("snapshot.bin"), bytes) && bytes.size() >= 24) {
+            uint64_t lsn, n;
+            std::memcpy(&lsn, bytes.data() + 4, 8);
+            std::memcpy(&n, bytes.data() + 12, 8);
+            uint32_t crcGravado;
+            bool tamanhoOk = n <= bytes.size() / 8 && bytes.size() == 20 + n * 8 + 4;
+            if (tamanhoOk) std::memcpy(&crcGravado, bytes.data() + 20 + n * 8, 4);
+            if (std::memcmp(bytes.data(), MAGICO_SNAPSHOT, 4) == 0 && tamanhoOk &&
+                crc32(bytes.data(), 20 + n * 8) == crcGravado) {
+                std::vector<double> valores(n);
+                std::memcpy(valores.data(), bytes.data() + 20, n * 8);
+                db->bulkLoad(valores);
+                rel.snapshotValido = true;
+                rel.lsnSnapshot = lsn;
+                rel.leiturasSnapshot = n;
+            } else {
+                std::cerr << "[Aviso] Snapshot invalido em '" << caminho("snapshot.bin")
+                          << "'; recuperando apenas pelo WAL." << std::endl;
+            }
+        }
+        rel.msSnapshot = (agoraNs() - t0) * 1e-6;
+    }
+
+    // Reaplica o WAL a partir do LSN do snapshot; devolve o tamanho válido do arquivo
+    size_t reaplicarWal(RelatorioRecuperacao& rel, uint64_t& ultimoLsn) {
+        long long t0 = agoraNs();
+        std::vector<unsigned char> bytes;
+        size_t valido = 0;
+        if (lerArquivo(caminho("wal.log"), bytes)) {
+            while (valido + TAM_REGISTRO <= bytes.size()) {
+                const unsigned char* reg = bytes.data() + valido;
+                uint32_t crc;
+                std::memcpy(&crc, reg + 17, 4);
+                if (crc32(reg, 17) != crc) break; // Escrita rasgada: o resto é lixo
+                uint64_t lsn;
+                double valor;
+                std::memcpy(&lsn, reg, 8);
+                std::memcpy(&valor, reg + 9, 8);
+                if (lsn > rel.lsnSnapshot) {
+                    if (reg[8] == OP_INSERT) db->insert(valor);
+                    else db->remove(valor);
+                    rel.opsReaplicadas++;
+                }
+                if (lsn > ultimoLsn) ultimoLsn = lsn;
+                valido += TAM_REGISTRO;
+            }
+            rel.bytesDescartados = bytes.size() - valido;
+        }
+        rel.msWal = (agoraNs() - t0) * 1e-6;
+        return valido;
+    }
+
+public:
+    BancoPersistente(std::unique_ptr<SensorDatabase> backend, const ConfigPersistencia& c)
+        : db(std::move(backend)), cfg(c) {
+        if (cfg.grupo == 0) cfg.grupo = 1;
+    }
+
+    ~BancoPersistente() override {
+        sincronizar();
+        if (fdWal >= 0) ::close(fdWal);
+    }
+
+    BancoPersistente(const BancoPersistente&) = delete;
+    BancoPersistente& operator=(const BancoPersistente&) = delete;
+
+    // Recupera o estado do diretório (snapshot + cauda do WAL) e abre o WAL para escrita.
+    // Chamar uma vez, antes de qualquer operação. Devolve false se o diretório/WAL não abrir.
+    bool abrir(RelatorioRecuperacao* relatorio = nullptr) {
+        if (::mkdir(cfg.diretorio.c_str(), 0755) != 0 && errno != EEXIST) {
+            registrarFalha("criar '" + cfg.diretorio + "'");
+            return false;
+        }
+        RelatorioRecuperacao rel;
+        carregarSnapshot(rel);
+        uint64_t ultimoLsn = rel.lsnSnapshot;
+        size_t valido = reaplicarWal(rel, ultimoLsn);
+        proximoLsn = ultimoLsn + 1;
+
+        fdWal = ::open(caminho("wal.log").c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fdWal < 0) {
+            registrarFalha("abrir WAL");
+            return false;
+        }
+        // Corta a cauda rasgada para que os próximos registros fiquem legíveis
+        if (rel.bytesDescartados > 0 && ::ftruncate(fdWal, valido) != 0) registrarFalha("truncar WAL");
+        sincronizarDiretorio();
+        if (relatorio) *relatorio = rel;
+        return !falhou;
+    }
+
+    // Grava os registros pendentes e faz fdatasync (fim do grupo)
+    void sincronizar() {
+        if (opsPendentes == 0 || fdWal < 0) return;
+        long long t0 = agoraNs();
+        if (!escreverTudo(fdWal, pendente.data(), pendente.size())) registrarFalha("escrever WAL");
+        else if (::fdatasync(fdWal) != 0) registrarFalha("fdatasync do WAL");
+        stats.nsEmFsync += agoraNs() - t0;
+        stats.fsyncs++;
+        pendente.clear();
+        opsPendentes = 0;
+    }
+
+    // Snapshot atômico do estado atual; depois dele o WAL recomeça vazio
+    bool snapshot() {
+        if (fdWal < 0) return false;
+        long long t0 = agoraNs();
+        sincronizar();
+        uint64_t lsn = proximoLsn - 1;
+        std::vector<double> valores = db->sortedValues();
+        uint64_t n = valores.size();
+
+        std::vector<unsigned char> bytes(20 + n * 8 + 4);
+        std::memcpy(bytes.data(), MAGICO_SNAPSHOT, 4);
+        std::memcpy(bytes.data() + 4, &lsn, 8);
+        std::memcpy(bytes.data() + 12, &n, 8);
+        if (n > 0) std::memcpy(bytes.data() + 20, valores.data(), n * 8);
+        uint32_t crc = crc32(bytes.data(), 20 + n * 8);
+        std::memcpy(bytes.data() + 20 + n * 8, &crc, 4);
+
+        std::string tmp = caminho("snapshot.bin.tmp");
+        int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            registrarFalha("criar snapshot");
+            return false;
+        }
+        bool ok = escreverTudo(fd, bytes.data(), bytes.size()) && ::fsync(fd) == 0;
+        ::close(fd);
+        if (!ok || ::rename(tmp.c_str(), caminho("snapshot.bin").c_str()) != 0) {
+            registrarFalha("gravar snapshot");
+            return false;
+        }
+        sincronizarDiretorio();
+
+        // O snapshot já cobre tudo até 'lsn': o WAL pode recomeçar
+        if (::ftruncate(fdWal, 0) != 0 || ::fdatasync(fdWal) != 0) registrarFalha("truncar WAL");
+        opsDesdeSnapshot = 0;
+        stats.snapshots++;
+        stats.nsEmSnapshot += agoraNs() - t0;
+        return true;
+    }
+
+    const EstatisticasPersistencia& estatisticas() const { return stats; }
+    bool saudavel() const { return !falhou; }
+    SensorDatabase& backend() { return *db; }
+
+    // --- Interface SensorDatabase: alterações passam pelo WAL, consultas vão direto ---
+    string getName() override { return db->getName() + " + WAL"; }
+
+    void insert(double value) override {
+        db->insert(value);
+        registrar(OP_INSERT, value);
+    }
+
+    void remove(double value) override {
+        db->remove(value);
+        registrar(OP_REMOVE, value);
+    }
+
+    // Carga em lote no backend; cada leitura ainda vai para o WAL
+    void bulkLoad(const vector<double>& sorted) override {
+        db->bulkLoad(sorted);
+        for (double v : sorted) registrar(OP_INSERT, v);
+    }
+
+    void printSorted() override { db->printSorted(); }
+    void getMinMax(int k) override { db->getMinMax(k); }
+    void rangeQuery(double minVal, double maxVal) override { db->rangeQuery(minVal, maxVal); }
+    double median() override { return db->median(); }
+    size_t size() override { return db->size(); }
+    double minValue() override { return db->minValue(); }
+    double maxValue() override { return db->maxValue(); }
+    vector<double> minK(int k) override { return db->minK(k); }
+    vector<double> maxK(int k) override { return db->maxK(k); }
+    vector<double> sortedValues() override { return db->sortedValues(); }
+};
+
+#endif
@@ -0,0 +1,299 @@
+#ifndef RESULTADOS_H
+#define RESULTADOS_H
+
+// Resultados de benchmark em formato de máquina (JSON/CSV) e modo de comparação
+// entre duas execuções, para acompanhar regressões entre versões.
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Medicao.h"
+
+struct ResultadoBenchmark {
+    std::string estrutura;
+    std::string operacao;
+    long long n = 0;
+    std::string distribuicao;
+    double nsPorOp = 0;                  // Mediana das amostras
+    double nsMinimo = 0, nsP95 = 0;
+    double icInferior = 0, icSuperior = 0;
+    double media = 0, desvio = 0;
+    int amostras = 0;
+    double bytesPorElemento = -1;        // -1 = não medido
+
+    std::string chave() const {
+        return estrutura + "|" + operacao + "|" + std::to_string(n) + "|" + distribuicao;
+    }
+};
+
+inline ResultadoBenchmark criarResultado(const std::string& estrutura, const std::string& operacao,
+                                         long long n, const std::string& distribuicao,
+                                         const Estatisticas& e, double bytesPorElemento = -1) {
+    ResultadoBenchmark r;
+    r.estrutura = estrutura;
+    r.operacao = operacao;
+    r.n = n;
+    r.distribuicao = distribuicao;
+    r.nsPorOp = e.mediana;
+    r.nsMinimo = e.minimo;
+    r.nsP95 = e.p95;
+    r.icInferior = e.icInferior;
+    r.icSuperior = e.icSuperior;
+    r.media = e.media;
+    r.desvio = e.desvio;
+    r.amostras = e.amostras;
+    r.bytesPorElemento = bytesPorElemento;
+    return r;
+}
+
+// --- Escrita ---
+
+inline std::string escaparJSON(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+inline bool salvarJSON(const std::string& caminho, const std::vector<ResultadoBenchmark>& resultados) {
+    std::ofstream arq(caminho);
+    if (!arq) {
+        std::cerr << "[ERRO] Nao foi possivel criar '" << caminho << "'.\n";
+        return false;
+    }
+    arq << std::setprecision(10);
+    arq << "{\n  \"formato\": \"sensor-bench-v1\",\n  \"resultados\": [\n";
+    for (size_t i = 0; i < resultados.size(); i++) {
+        const ResultadoBenchmark& r = resultados[i];
+        arq << "    {\"estrutura\": \"" << escaparJSON(r.estrutura) << "\""
+            << ", \"operacao\": \"" << escaparJSON(r.operacao) << "\""
+            << ", \"n\": " << r.n
+            << ", \"distribuicao\": \"" << escaparJSON(r.distribuicao) << "\""
+            << ", \"ns_por_op\": " << r.nsPorOp
+            << ", \"ns_min\": " << r.nsMinimo
+            << ", \"ns_p95\": " << r.nsP95
+            << ", \"ic_inf\": " << r.icInferior
+            << ", \"ic_sup\": " << r.icSuperior
+            << ", \"media\": " << r.media
+            << ", \"desvio\": " << r.desvio
+            << ", \"amostras\": " << r.amostras
+            << ", \"bytes_por_elemento\": " << r.bytesPorElemento << "}"
+            << (i + 1 < resultados.size() ? ",\n" : "\n");
+    }
+    arq << "  ]\n}\n";
+    return true;
+}
+
+inline std::string escaparCSV(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
+
+inline bool salvarCSV(const std::string& caminho, const std::vector<ResultadoBenchmark>& resultados) {
+    std::ofstream arq(caminho);
+    if (!arq) {
+        std::cerr << "[ERRO] Nao foi possivel criar '" << caminho << "'.\n";
+        return false;
+    }
+    arq << std::setprecision(10);
+    arq << "estrutura,operacao,n,distribuicao,ns_por_op,ns_min,ns_p95,ic_inf,ic_sup,media,desvio,amostras,bytes_por_elemento\n";
+    for (const ResultadoBenchmark& r : resultados) {
+        arq << escaparCSV(r.estrutura) << "," << escaparCSV(r.operacao) << "," << r.n << ","
+            << escaparCSV(r.distribuicao) << "," << r.nsPorOp << "," << r.nsMinimo << "," << r.nsP95 << ","
+            << r.icInferior << "," << r.icSuperior << "," << r.media << "," << r.desvio << ","
+            << r.amostras << "," << r.bytesPorElemento << "\n";
+    }
+    return true;
+}
+
+// Escolhe o formato pela extensão (.csv ou JSON por padrão)
+inline bool salvarResultados(const std::string& caminho, const std::vector<ResultadoBenchmark>& resultados) {
+    bool csv = caminho.size() >= 4 && caminho.compare(caminho.size() - 4, 4, ".csv") == 0;
+    return csv ? salvarCSV(caminho, resultados) : salvarJSON(caminho, resultados);
+}
+
+// --- Leitura ---
+
+inline void atribuirCampo(ResultadoBenchmark& r, const std::string& campo, const std::string& valor) {
+    double num = std::atof(valor.c_str());
+    if (campo == "estrutura") r.estrutura = valor;
+    else if (campo == "operacao") r.operacao = valor;
+    else if (campo == "n") r.n = std::atoll(valor.c_str());
+    else if (campo == "distribuicao") r.distribuicao = valor;
+    else if (campo == "ns_por_op") r.nsPorOp = num;
+    else if (campo == "ns_min") r.nsMinimo = num;
+    else if (campo == "ns_p95") r.nsP95 = num;
+    else if (campo == "ic_inf") r.icInferior = num;
+    else if (campo == "ic_sup") r.icSuperior = num;
+    else if (campo == "media") r.media = num;
+    else if (campo == "desvio") r.desvio = num;
+    else if (campo == "amostras") r.amostras = std::atoi(valor.c_str());
+    else if (campo == "bytes_por_elemento") r.bytesPorElemento = num;
+}
+
+// Leitor mínimo para o JSON gerado por salvarJSON (objetos planos com strings e números)
+inline std::vector<ResultadoBenchmark> lerJSON(const std::string& texto) {
+    std::vector<ResultadoBenchmark> resultados;
+    size_t i = texto.find("\"resultados\"");
+    if (i == std::string::npos) return resultados;
+
+    auto lerString = [&](size_t& p) {
+        std::string s;
+        for (p++; p < texto.size() && texto[p] != '"'; p++) {
+            if (texto[p] == '\\' && p + 1 < texto.size()) p++;
+            s += texto[p];
+        }
+        p++;
+        return s;
+    };
+
+    while ((i = texto.find('{', i)) != std::string::npos) {
+        ResultadoBenchmark r;
+        size_t p = i + 1;
+        while (p < texto.size() && texto[p] != '}') {
+            if (texto[p] != '"') { p++; continue; }
+            std::string campo = lerString(p);
+            p = texto.find(':', p) + 1;
+            while (p < texto.size() && std::isspace((unsigned char)texto[p])) p++;
+            std::string valor;
+            if (texto[p] == '"') valor = lerString(p);
+            else {
+                while (p < texto.size() && texto[p] != ',' && texto[p] != '}') valor += texto[p++];
+            }
+            atribuirCampo(r, campo, valor);
+        }
+        resultados.push_back(r);
+        i = p;
+    }
+    return resultados;
+}
+
+inline std::vector<std::string> dividirLinhaCSV(const std::string& linha) {
+    std::vector<std::string> campos;
+    std::string atual;
+    bool entreAspas = false;
+    for (size_t i = 0; i < linha.size(); i++) {
+        char c = linha[i];
+        if (entreAspas) {
+            if (c == '"' && i + 1 < linha.size() && linha[i + 1] == '"') { atual += '"'; i++; }
+            else if (c == '"') entreAspas = false;
+            else atual += c;
+        } else if (c == '"') entreAspas = true;
+        else if (c == ',') { campos.push_back(atual); atual.clear(); }
+        else if (c != '\r') atual += c;
+    }
+    campos.push_back(atual);
+    return campos;
+}
+
+inline std::vector<ResultadoBenchmark> lerCSV(std::istream& entrada) {
+    std::vector<ResultadoBenchmark> resultados;
+    std::string linha;
+    if (!std::getline(entrada, linha)) return resultados;
+    std::vector<std::string> cabecalho = dividirLinhaCSV(linha);
+    while (std::getline(entrada, linha)) {
+        if (linha.empty()) continue;
+        std::vector<std::string> campos = dividirLinhaCSV(linha);
+        ResultadoBenchmark r;
+        for (size_t c = 0; c < campos.size() && c < cabecalho.size(); c++) atribuirCampo(r, cabecalho[c], campos[c]);
+        resultados.push_back(r);
+    }
+    return resultados;
+}
+
+inline std::vector<ResultadoBenchmark> carregarResultados(const std::string& caminho) {
+    std::ifstream arq(caminho);
+    if (!arq) {
+        std::cerr << "[ERRO] Arquivo '" << caminho << "' nao encontrado.\n";
+        return {};
+    }
+    std::stringstream ss;
+    ss << arq.rdbuf();
+    std::string texto = ss.str();
+    size_t inicio = texto.find_first_not_of(" \t\r\n");
+    if (inicio != std::string::npos && texto[inicio] == '{') return lerJSON(texto);
+    std::istringstream entrada(texto);
+    return lerCSV(entrada);
+}
+
+// --- Comparação ---
+
+// Quantil 0.975 da t de Student (aproximação de Cornish-Fisher, boa para gl >= 3)
+inline double quantilT975(double gl) {
+    const double z = 1.959964;
+    double z3 = z * z * z, z5 = z3 * z * z;
+    return z + (z3 + z) / (4 * gl) + (5 * z5 + 16 * z3 + 3 * z) / (96 * gl * gl);
+}
+
+// Teste t de Welch sobre média/desvio/amostras: diferença significativa a 95%?
+// Retorna false quando não há amostras suficientes para testar.
+inline bool diferencaSignificativa(const ResultadoBenchmark& a, const ResultadoBenchmark& b, bool& testavel) {
+    testavel = a.amostras >= 2 && b.amostras >= 2;
+    if (!testavel) return false;
+    double va = a.desvio * a.desvio / a.amostras;
+    double vb = b.desvio * b.desvio / b.amostras;
+    if (va + vb == 0) return a.media != b.media;
+    double t = std::fabs(a.media - b.media) / std::sqrt(va + vb);
+    double gl = (va + vb) * (va + vb) /
+                ((a.amostras > 1 ? va * va / (a.amostras - 1) : 0) + (b.amostras > 1 ? vb * vb / (b.amostras - 1) : 0));
+    return t > quantilT975(std::max(gl, 1.0));
+}
+
+// Compara 'novo' contra 'base'. Uma regressão exige diferença estatisticamente
+// significativa E variação da mediana acima de 'limiarPct'.
+// Retorna o número de regressões encontradas.
+inline int compararResultados(const std::vector<ResultadoBenchmark>& base,
+                              const std::vector<ResultadoBenchmark>& novo, double limiarPct) {
+    std::map<std::string, const ResultadoBenchmark*> indiceBase;
+    for (const ResultadoBenchmark& r : base) indiceBase[r.chave()] = &r;
+
+    int regressoes = 0, melhorias = 0, semPar = 0;
+    std::cout << std::left << std::setw(34) << "Estrutura" << std::setw(18) << "Operacao" << std::right
+              << std::setw(10) << "N" << std::setw(14) << "Base ns/op" << std::setw(14) << "Novo ns/op"
+              << std::setw(10) << "Delta" << "  Veredito" << std::endl;
+
+    for (const ResultadoBenchmark& r : novo) {
+        auto it = indiceBase.find(r.chave());
+        if (it == indiceBase.end()) { semPar++; continue; }
+        const ResultadoBenchmark& b = *it->second;
+
+        double delta = b.nsPorOp > 0 ? 100.0 * (r.nsPorOp - b.nsPorOp) / b.nsPorOp : 0.0;
+        bool testavel;
+        bool significativa = diferencaSignificativa(b, r, testavel);
+        std::string veredito = "igual";
+        if (std::fabs(delta) >= limiarPct && (significativa || !testavel)) {
+            veredito = delta > 0 ? "REGRESSAO" : "melhoria";
+            if (!testavel) veredito += " (sem amostras p/ teste)";
+            if (delta > 0) regressoes++; else melhorias++;
+        } else if (std::fabs(delta) >= limiarPct) {
+            veredito = "ruido";
+        }
+
+        std::cout << std::left << std::setw(34) << r.estrutura.substr(0, 33) << std::setw(18) << r.operacao
+                  << std::right << std::setw(10) << r.n << std::fixed << std::setprecision(1)
+                  << std::setw(14) << b.nsPorOp << std::setw(14) << r.nsPorOp
+                  << std::setw(9) << std::showpos << delta << std::noshowpos << "%  " << veredito << std::endl;
+    }
+
+    std::cout << "\nRegressoes: " << regressoes << " | Melhorias: " << melhorias
+              << " | Sem correspondencia na base: " << semPar
+              << " (limiar " << limiarPct << "%, Welch 95%)" << std::endl;
+    return regressoes;
+}
+
+#endif
@@ -0,0 +1,124 @@
+// Demonstração do histórico comprimido: gera anos de leituras de um sensor
+// (temperatura variando devagar, 2 casas decimais), compacta nos modos XOR e
+// ponto fixo, confere a ida e volta e reconstrói uma SensorAVL com o último mês.
+//
+// Uso:
+//   ./serie_comprimida [--dias N] [--intervalo-s S] [--casas C] [--semente S]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#define SENSOR_SEM_MAIN
+#include "Versao aprimorada_AVL tree.cpp"
+#include "Medicao.h"
+#include "SerieComprimida.h"
+
+struct ConfigSerie {
+    int dias = 365;
+    int intervaloS = 60;
+    int casas = 2;
+    unsigned semente = 42;
+};
+
+// Ciclo diário + passeio aleatório lento; ~1% das leituras chegam com atraso de 1 s
+vector<pair<int64_t, double>> gerarLeituras(const ConfigSerie& cfg) {
+    mt19937_64 rng(cfg.semente);
+    normal_distribution<double> passo(0.0, 0.02);
+    bernoulli_distribution atraso(0.01);
+    double escala = pow(10.0, cfg.casas);
+
+    vector<pair<int64_t, double>> leituras;
+    int64_t total = (int64_t)cfg.dias * 86400 / cfg.intervaloS;
+    leituras.reserve(total);
+    int64_t instante = 1700000000; // Epoch em segundos
+    double deriva = 0.0;
+    for (int64_t i = 0; i < total; i++) {
+        deriva = max(-5.0, min(5.0, deriva + passo(rng)));
+        double ciclo = 6.0 * sin(2 * M_PI * (instante % 86400) / 86400.0);
+        double v = round((22.0 + ciclo + deriva) * escala) / escala;
+        leituras.push_back({instante + (atraso(rng) ? 1 : 0), v});
+        instante += cfg.intervaloS;
+    }
+    return leituras;
+}
+
+void avaliarModo(const char* nome, CodificacaoValor modo, const ConfigSerie& cfg,
+                 const vector<pair<int64_t, double>>& leituras) {
+    SerieComprimida serie(modo, cfg.casas);
+
+    long long t0 = agoraNs();
+    for (const auto& l : leituras) serie.anexar(l.first, l.second);
+    double nsCodificar = (double)(agoraNs() - t0) / leituras.size();
+
+    // Decodificação em fluxo, conferindo cada leitura
+    size_t i = 0, divergencias = 0;
+    double soma = 0;
+    t0 = agoraNs();
+    serie.paraCada([&](int64_t t, double v) {
+        if (i >= leituras.size() || t != leituras[i].first || v != leituras[i].second) divergencias++;
+        soma += v;
+        i++;
+    });
+    double nsDecodificar = (double)(agoraNs() - t0) / leituras.size();
+    naoOtimizar(soma);
+
+    size_t bytesBrutos = leituras.size() * (sizeof(int64_t) + sizeof(double));
+    cout << left << setw(12) << nome << right << fixed << setprecision(2)
+         << setw(12) << serie.bitsPorLeitura()
+         << setw(14) << serie.bytesUsados() / (1024.0 * 1024.0)
+         << setw(10) << (double)bytesBrutos / serie.bytesUsados() << "x"
+         << setw(12) << nsCodificar << setw(12) << nsDecodificar
+         << setw(8) << serie.numBlocos()
+         << "   " << (divergencias == 0 && i == leituras.size() ? "sem perdas" : "DIVERGIU") << endl;
+
+    // Reconstrução de um índice a partir do histórico (último mês)
+    if (modo == CodificacaoValor::XOR) {
+        int64_t fim = leituras.back().first, inicio = fim - 30LL * 86400;
+        SensorAVL avl;
+        avl.setVerbose(false);
+        t0 = agoraNs();
+        reconstruirEntre(serie, inicio, fim, avl);
+        double ms = (agoraNs() - t0) * 1e-6;
+        cout << "            SensorAVL reconstruida com os ultimos 30 dias: " << avl.size()
+             << " leituras em " << setprecision(1) << ms << " ms, mediana = " << setprecision(2)
+             << avl.median() << endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    ConfigSerie cfg;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        if (arg == "--dias" && temValor) cfg.dias = atoi(argv[++i]);
+        else if (arg == "--intervalo-s" && temValor) cfg.intervaloS = atoi(argv[++i]);
+        else if (arg == "--casas" && temValor) cfg.casas = atoi(argv[++i]);
+        else if (arg == "--semente" && temValor) cfg.semente = strtoul(argv[++i], nullptr, 10);
+        else {
+            cerr << "Uso: serie_comprimida [--dias N] [--intervalo-s S] [--casas C] [--semente S]" << endl;
+            return 1;
+        }
+    }
+    if (cfg.dias <= 0 || cfg.intervaloS <= 0 || cfg.casas < 0) {
+        cerr << "[ERRO] --dias e --intervalo-s devem ser positivos." << endl;
+        return 1;
+    }
+
+    vector<pair<int64_t, double>> leituras = gerarLeituras(cfg);
+    cout << ">>> " << leituras.size() << " leituras (" << cfg.dias << " dias, 1 a cada " << cfg.intervaloS
+         << " s). Bruto: " << fixed << setprecision(2)
+         << leituras.size() * 16 / (1024.0 * 1024.0) << " MB (16 bytes/leitura)\n\n";
+
+    cout << left << setw(12) << "Modo" << right << setw(12) << "Bits/leit" << setw(14) << "MB"
+         << setw(11) << "Taxa" << setw(12) << "ns/anexar" << setw(12) << "ns/decod"
+         << setw(8) << "Blocos" << endl;
+    avaliarModo("XOR", CodificacaoValor::XOR, cfg, leituras);
+    avaliarModo("Ponto fixo", CodificacaoValor::PontoFixo, cfg, leituras);
+    return 0;
+}
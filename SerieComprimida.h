@@ -0,0 +1,274 @@
+#ifndef SERIE_COMPRIMIDA_H
+#define SERIE_COMPRIMIDA_H
+
+// Armazenamento histórico comprimido (estilo Gorilla), só de anexação.
+//
+// As leituras (instante, valor) são gravadas em blocos de fluxo de bits:
+//  - instante: delta-do-delta (leituras periódicas custam 1 bit cada);
+//  - valor, modo XOR: XOR com o valor anterior, guardando só os bits que
+//    mudaram (sem perdas para qualquer double);
+//  - valor, modo ponto fixo: delta de inteiros em 10^-casas (sem perdas para
+//    leituras com até 'casas' decimais, como as do sensor; arredonda as demais).
+// Temperaturas que variam devagar ficam com poucos bits por leitura.
+//
+// A decodificação é em fluxo (um bloco por vez, sem materializar a série) e
+// pode alimentar qualquer estrutura com insert(valor), ex: SensorAVL.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+enum class CodificacaoValor { XOR, PontoFixo };
+
+// --- Fluxo de bits (MSB primeiro dentro de cada palavra de 64 bits) ---
+inline void escreverBits(std::vector<uint64_t>& palavras, uint64_t& nBits, uint64_t valor, int n) {
+    if (n == 0) return;
+    if (n < 64) valor &= (1ULL << n) - 1;
+    int ocupados = (int)(nBits & 63);
+    if (ocupados == 0) palavras.push_back(0);
+    int livres = 64 - ocupados;
+    if (n <= livres) {
+        palavras.back() |= valor << (livres - n);
+    } else {
+        palavras.back() |= valor >> (n - livres);
+        palavras.push_back(valor << (64 - (n - livres)));
+    }
+    nBits += n;
+}
+
+class LeitorBits {
+private:
+    const uint64_t* palavras;
+    uint64_t pos = 0;
+
+public:
+    explicit LeitorBits(const uint64_t* p) : palavras(p) {}
+
+    uint64_t ler(int n) {
+        if (n == 0) return 0;
+        size_t w = pos >> 6;
+        int deslocamento = (int)(pos & 63);
+        int disponiveis = 64 - deslocamento;
+        uint64_t r = (palavras[w] << deslocamento) >> (64 - n);
+        if (n > disponiveis) r |= palavras[w + 1] >> (64 - (n - disponiveis));
+        pos += n;
+        return r;
+    }
+
+    bool lerBit() { return ler(1) != 0; }
+};
+
+// --- Inteiros com sinal em tamanho variável (zigzag + prefixo unário) ---
+// '0' = zero; '10'+7 bits; '110'+9; '1110'+12; '11110'+32; '11111'+64
+inline uint64_t zigzag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+inline int64_t desfazerZigzag(uint64_t z) { return (int64_t)(z >> 1) ^ -(int64_t)(z & 1); }
+
+const int BITS_FAIXA_INTEIRO[] = {7, 9, 12, 32, 64};
+
+inline void escreverInteiro(std::vector<uint64_t>& palavras, uint64_t& nBits, int64_t v) {
+    if (v == 0) {
+        escreverBits(palavras, nBits, 0, 1);
+        return;
+    }
+    uint64_t z = zigzag(v);
+    for (int f = 0; f < 5; f++) {
+        int bits = BITS_FAIXA_INTEIRO[f];
+        if (bits == 64 || z < (1ULL << bits)) {
+            // f+1 uns seguidos de um zero (a última faixa dispensa o zero)
+            int tamPrefixo = f < 4 ? f + 2 : 5;
+            uint64_t prefixo = f < 4 ? ((1ULL << (f + 1)) - 1) << 1 : 0x1F;
+            escreverBits(palavras, nBits, prefixo, tamPrefixo);
+            escreverBits(palavras, nBits, z, bits);
+            return;
+        }
+    }
+}
+
+inline int64_t lerInteiro(LeitorBits& leitor) {
+    if (!leitor.lerBit()) return 0;
+    int f = 0;
+    while (f < 4 && leitor.lerBit()) f++;
+    return desfazerZigzag(leitor.ler(BITS_FAIXA_INTEIRO[f]));
+}
+
+inline uint64_t bitsDeDouble(double v) {
+    uint64_t b;
+    std::memcpy(&b, &v, sizeof(b));
+    return b;
+}
+
+inline double doubleDeBits(uint64_t b) {
+    double v;
+    std::memcpy(&v, &b, sizeof(v));
+    return v;
+}
+
+// --- Bloco: a primeira leitura fica no cabeçalho, as demais no fluxo ---
+struct BlocoSerie {
+    int64_t primeiroInstante = 0, ultimoInstante = 0;
+    uint64_t primeiroValor = 0; // Bits do double (XOR) ou inteiro em ponto fixo
+    uint32_t quantidade = 0;
+    std::vector<uint64_t> palavras;
+    uint64_t nBits = 0;
+};
+
+// Estado compartilhado por codificador e decodificador (evoluem igual)
+struct EstadoSerie {
+    int64_t instante = 0, delta = 0;
+    uint64_t valor = 0; // Bits do último double ou último inteiro em ponto fixo
+    int lider = -1, cauda = 0; // Janela de bits significativos do último XOR
+};
+
+class SerieComprimida {
+private:
+    CodificacaoValor modo;
+    double escala;
+    uint32_t leiturasPorBloco;
+    std::vector<BlocoSerie> blocos;
+    EstadoSerie estado; // Do bloco aberto (o último)
+    size_t total = 0;
+
+    uint64_t paraInteiro(double v) const {
+        return modo == CodificacaoValor::XOR ? bitsDeDouble(v) : (uint64_t)std::llround(v * escala);
+    }
+
+    double deInteiro(uint64_t u) const {
+        return modo == CodificacaoValor::XOR ? doubleDeBits(u) : (double)(int64_t)u / escala;
+    }
+
+    static void codificarXOR(BlocoSerie& b, EstadoSerie& e, uint64_t bits) {
+        uint64_t x = bits ^ e.valor;
+        if (x == 0) {
+            escreverBits(b.palavras, b.nBits, 0, 1);
+            return;
+        }
+        escreverBits(b.palavras, b.nBits, 1, 1);
+        int lider = __builtin_clzll(x), cauda = __builtin_ctzll(x);
+        if (lider > 31) lider = 31; // Cabe em 5 bits
+        if (e.lider >= 0 && lider >= e.lider && cauda >= e.cauda) {
+            // Reaproveita a janela anterior
+            escreverBits(b.palavras, b.nBits, 0, 1);
+            escreverBits(b.palavras, b.nBits, x >> e.cauda, 64 - e.lider - e.cauda);
+        } else {
+            int significativos = 64 - lider - cauda;
+            escreverBits(b.palavras, b.nBits, 1, 1);
+            escreverBits(b.palavras, b.nBits, lider, 5);
+            escreverBits(b.palavras, b.nBits, significativos - 1, 6);
+            escreverBits(b.palavras, b.nBits, x >> cauda, significativos);
+            e.lider = lider;
+            e.cauda = cauda;
+        }
+    }
+
+    static uint64_t decodificarXOR(LeitorBits& leitor, EstadoSerie& e) {
+        if (!leitor.lerBit()) return e.valor;
+        if (leitor.lerBit()) {
+            e.lider = (int)leitor.ler(5);
+            int significativos = (int)leitor.ler(6) + 1;
+            e.cauda = 64 - e.lider - significativos;
+        }
+        uint64_t x = leitor.ler(64 - e.lider - e.cauda) << e.cauda;
+        return e.valor ^ x;
+    }
+
+public:
+    // 'casasDecimais' só vale no modo ponto fixo
+    explicit SerieComprimida(CodificacaoValor m = CodificacaoValor::XOR, int casasDecimais = 2,
+                             uint32_t porBloco = 1024)
+        : modo(m), escala(std::pow(10.0, casasDecimais)), leiturasPorBloco(porBloco) {}
+
+    // Instantes em qualquer unidade inteira (s, ms...), não decrescentes.
+    // Devolve false (e ignora) se o instante for anterior ao último anexado.
+    bool anexar(int64_t instante, double valor) {
+        if (total > 0 && instante < estado.instante) return false;
+        uint64_t v = paraInteiro(valor);
+
+        if (blocos.empty() || blocos.back().quantidade >= leiturasPorBloco) {
+            if (!blocos.empty()) blocos.back().palavras.shrink_to_fit(); // Bloco selado
+            blocos.emplace_back();
+            BlocoSerie& b = blocos.back();
+            b.primeiroInstante = b.ultimoInstante = instante;
+            b.primeiroValor = v;
+            b.quantidade = 1;
+            estado = EstadoSerie();
+            estado.instante = instante;
+            estado.valor = v;
+            total++;
+            return true;
+        }
+
+        BlocoSerie& b = blocos.back();
+        int64_t delta = instante - estado.instante;
+        escreverInteiro(b.palavras, b.nBits, delta - estado.delta);
+        if (modo == CodificacaoValor::XOR) codificarXOR(b, estado, v);
+        else escreverInteiro(b.palavras, b.nBits, (int64_t)(v - estado.valor));
+
+        estado.delta = delta;
+        estado.instante = instante;
+        estado.valor = v;
+        b.ultimoInstante = instante;
+        b.quantidade++;
+        total++;
+        return true;
+    }
+
+    // Decodifica um bloco em fluxo, chamando f(instante, valor) em ordem
+    template <typename F>
+    void decodificarBloco(const BlocoSerie& b, F&& f) const {
+        EstadoSerie e;
+        e.instante = b.primeiroInstante;
+        e.valor = b.primeiroValor;
+        f(e.instante, deInteiro(e.valor));
+        LeitorBits leitor(b.palavras.data());
+        for (uint32_t i = 1; i < b.quantidade; i++) {
+            e.delta += lerInteiro(leitor);
+            e.instante += e.delta;
+            if (modo == CodificacaoValor::XOR) e.valor = decodificarXOR(leitor, e);
+            else e.valor += (uint64_t)lerInteiro(leitor);
+            f(e.instante, deInteiro(e.valor));
+        }
+    }
+
+    template <typename F>
+    void paraCada(F&& f) const {
+        for (const BlocoSerie& b : blocos) decodificarBloco(b, f);
+    }
+
+    // Só as leituras com instante em [inicio, fim]; blocos fora da faixa nem são lidos
+    template <typename F>
+    void paraCadaEntre(int64_t inicio, int64_t fim, F&& f) const {
+        for (const BlocoSerie& b : blocos) {
+            if (b.ultimoInstante < inicio || b.primeiroInstante > fim) continue;
+            decodificarBloco(b, [&](int64_t t, double v) {
+                if (t >= inicio && t <= fim) f(t, v);
+            });
+        }
+    }
+
+    size_t quantidade() const { return total; }
+    size_t numBlocos() const { return blocos.size(); }
+    CodificacaoValor codificacao() const { return modo; }
+
+    // Bytes ocupados: fluxos de bits + cabeçalhos dos blocos
+    size_t bytesUsados() const {
+        size_t bytes = sizeof(*this) + blocos.capacity() * sizeof(BlocoSerie);
+        for (const BlocoSerie& b : blocos) bytes += b.palavras.capacity() * sizeof(uint64_t);
+        return bytes;
+    }
+
+    double bitsPorLeitura() const { return total ? 8.0 * bytesUsados() / total : 0.0; }
+};
+
+// Reconstrói um índice (SensorAVL, SensorDatabase...) a partir do histórico
+template <typename Banco>
+void reconstruir(const SerieComprimida& serie, Banco& banco) {
+    serie.paraCada([&](int64_t, double valor) { banco.insert(valor); });
+}
+
+template <typename Banco>
+void reconstruirEntre(const SerieComprimida& serie, int64_t inicio, int64_t fim, Banco& banco) {
+    serie.paraCadaEntre(inicio, fim, [&](int64_t, double valor) { banco.insert(valor); });
+}
+
+#endif
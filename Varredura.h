@@ -0,0 +1,247 @@
+#ifndef VARREDURA_H
+#define VARREDURA_H
+
+// Varredura de escala: mede cada operação de um backend para N crescente
+// (1e3 .. 1e8), pula tamanhos cuja projeção de tempo ou de memória estoura o
+// orçamento e ajusta os custos medidos aos modelos O(1), O(log N), O(N) e O(N log N).
+// Também registra os bytes por elemento de cada backend em cada N.
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Medicao.h"
+#include "Resultados.h"
+
+enum class Complexidade { O1, OLogN, ON, ONLogN };
+
+inline const char* nomeComplexidade(Complexidade c) {
+    switch (c) {
+        case Complexidade::O1: return "O(1)";
+        case Complexidade::OLogN: return "O(log N)";
+        case Complexidade::ON: return "O(N)";
+        case Complexidade::ONLogN: return "O(N log N)";
+    }
+    return "?";
+}
+
+inline double avaliarModelo(Complexidade c, double n) {
+    switch (c) {
+        case Complexidade::O1: return 1.0;
+        case Complexidade::OLogN: return std::log2(n);
+        case Complexidade::ON: return n;
+        case Complexidade::ONLogN: return n * std::log2(n);
+    }
+    return 1.0;
+}
+
+struct AjusteComplexidade {
+    bool valido = false;
+    Complexidade modelo = Complexidade::O1;
+    double coeficiente = 0;   // custo(N) ~= coeficiente * f(N)
+    double rmsRelativo = 0;   // Erro médio quadrático relativo do ajuste
+};
+
+// Mínimos quadrados de um parâmetro (custo = c * f(N)) com erro relativo,
+// para que os N pequenos pesem tanto quanto os grandes. Vence o menor erro.
+inline AjusteComplexidade ajustarComplexidade(const std::vector<double>& ns, const std::vector<double>& custos) {
+    AjusteComplexidade melhor;
+    if (ns.size() < 2 || ns.size() != custos.size()) return melhor;
+
+    const Complexidade modelos[] = {Complexidade::O1, Complexidade::OLogN, Complexidade::ON, Complexidade::ONLogN};
+    for (Complexidade m : modelos) {
+        double num = 0, den = 0;
+        for (size_t i = 0; i < ns.size(); i++) {
+            double f = avaliarModelo(m, ns[i]) / custos[i];
+            num += f;
+            den += f * f;
+        }
+        if (den == 0) continue;
+        double c = num / den;
+
+        double erro = 0;
+        for (size_t i = 0; i < ns.size(); i++) {
+            double r = (custos[i] - c * avaliarModelo(m, ns[i])) / custos[i];
+            erro += r * r;
+        }
+        double rms = std::sqrt(erro / ns.size());
+        if (!melhor.valido || rms < melhor.rmsRelativo) {
+            melhor.valido = true;
+            melhor.modelo = m;
+            melhor.coeficiente = c;
+            melhor.rmsRelativo = rms;
+        }
+    }
+    return melhor;
+}
+
+struct ConfigVarredura {
+    long long nMin = 1000;
+    long long nMax = 100000000;
+    double orcamentoS = 10.0;     // Tempo máximo projetado por backend e por N
+    double memoriaMaxMB = 1024;   // Memória máxima projetada (backend + dados de entrada)
+    unsigned semente = 42;
+    int remocoes = 100;
+    double leiturasNaFaixa = 100; // Largura da faixa escolhida para ~100 resultados
+};
+
+// Operações medidas na varredura (mesma ordem em todos os relatórios)
+inline const std::vector<std::string>& operacoesVarredura() {
+    static const std::vector<std::string> ops = {"insercao", "mediana", "busca_faixa", "remocao"};
+    return ops;
+}
+
+// Tamanhos em meia-década: 1e3, 3.2e3, 1e4, ... até nMax
+inline std::vector<long long> tamanhosVarredura(const ConfigVarredura& cfg) {
+    std::vector<long long> tamanhos;
+    for (double n = cfg.nMin; n <= cfg.nMax * 1.0001; n *= std::sqrt(10.0)) tamanhos.push_back(std::llround(n));
+    return tamanhos;
+}
+
+struct PontoVarredura {
+    long long n = 0;
+    std::map<std::string, double> nsPorOp;
+    double bytesPorElemento = 0;
+};
+
+// Projeta o tempo de parede de uma rodada em N a partir dos ajustes já feitos
+inline double projetarSegundos(const std::map<std::string, AjusteComplexidade>& ajustes, long long n,
+                               const ConfigVarredura& cfg, const ConfigMedicao& med) {
+    double total = 0;
+    for (const auto& par : ajustes) {
+        if (!par.second.valido) continue;
+        double nsOp = par.second.coeficiente * avaliarModelo(par.second.modelo, (double)n);
+        double chamadas = 1;
+        if (par.first == "insercao") chamadas = n;
+        else if (par.first == "remocao") chamadas = cfg.remocoes;
+        else {
+            // Operações repetíveis: o harness roda lotes de >= alvoNsPorAmostra por amostra
+            double porAmostra = std::max((double)med.alvoNsPorAmostra, nsOp);
+            total += (med.amostras + 2) * porAmostra * 1e-9 + med.aquecimento * nsOp * 1e-9;
+            continue;
+        }
+        total += chamadas * nsOp * 1e-9;
+    }
+    return total;
+}
+
+// Varre um backend. 'criar' devolve um banco vazio (unique_ptr para algo com a API de SensorDatabase,
+// incluindo memoryUsage()).
+// 'declarado' traz a complexidade prometida nos comentários do código para cada operação.
+template <typename Criar>
+std::vector<PontoVarredura> varrerBackend(const std::string& nome, Criar criar,
+                                          const std::map<std::string, Complexidade>& declarado,
+                                          const ConfigVarredura& cfg,
+                                          std::vector<ResultadoBenchmark>* resultados = nullptr) {
+    ConfigMedicao med;
+    med.amostras = 11;
+    med.alvoNsPorAmostra = 1000000;
+
+    std::vector<PontoVarredura> pontos;
+    std::map<std::string, AjusteComplexidade> ajustes;
+    std::mt19937_64 gerador(cfg.semente);
+    std::uniform_real_distribution<double> temperatura(0.0, 1000.0);
+
+    std::cout << "\n=== Varredura: " << nome << " ===" << std::endl;
+    std::cout << std::left << std::setw(12) << "N" << std::right;
+    for (const std::string& op : operacoesVarredura()) std::cout << std::setw(16) << op;
+    std::cout << std::setw(12) << "B/elem" << "   (ns/op)" << std::endl;
+
+    for (long long n : tamanhosVarredura(cfg)) {
+        if (pontos.size() >= 2) {
+            double projecao = projetarSegundos(ajustes, n, cfg, med);
+            if (projecao > cfg.orcamentoS) {
+                std::cout << std::left << std::setw(12) << n << "pulado: projecao de " << std::fixed
+                          << std::setprecision(1) << projecao << " s excede o orcamento de " << cfg.orcamentoS
+                          << " s" << std::endl;
+                break; // N maiores só custariam mais
+            }
+        }
+        if (!pontos.empty()) {
+            // Bytes/elemento do maior N já medido + o vetor de entrada (8 bytes por leitura)
+            double projecaoMB = (pontos.back().bytesPorElemento + sizeof(double)) * n / (1024.0 * 1024.0);
+            if (projecaoMB > cfg.memoriaMaxMB) {
+                std::cout << std::left << std::setw(12) << n << "pulado: projecao de " << std::fixed
+                          << std::setprecision(0) << projecaoMB << " MB excede o limite de " << cfg.memoriaMaxMB
+                          << " MB" << std::endl;
+                break;
+            }
+        }
+
+        std::vector<double> dados(n);
+        for (double& v : dados) v = temperatura(gerador);
+        auto db = criar();
+        PontoVarredura p;
+        p.n = n;
+
+        long long inicio = agoraNs();
+        for (double v : dados) db->insert(v);
+        p.nsPorOp["insercao"] = (double)(agoraNs() - inicio) / n;
+        p.bytesPorElemento = (double)db->memoryUsage().bytesVivos / n;
+
+        p.nsPorOp["mediana"] = medirRepetivel([&]() { return db->median(); }, med).mediana;
+
+        double largura = cfg.leiturasNaFaixa * 1000.0 / n;
+        double a = 500.0 - largura / 2, b = 500.0 + largura / 2;
+        p.nsPorOp["busca_faixa"] = medirRepetivel([&]() { db->rangeQuery(a, b); return 0; }, med).mediana;
+
+        std::uniform_int_distribution<long long> indice(0, n - 1);
+        std::vector<double> alvos;
+        for (int i = 0; i < cfg.remocoes; i++) alvos.push_back(dados[indice(gerador)]);
+        inicio = agoraNs();
+        for (double v : alvos) db->remove(v);
+        p.nsPorOp["remocao"] = (double)(agoraNs() - inicio) / cfg.remocoes;
+
+        std::cout << std::left << std::setw(12) << n << std::right << std::fixed << std::setprecision(1);
+        for (const std::string& op : operacoesVarredura()) std::cout << std::setw(16) << p.nsPorOp[op];
+        std::cout << std::setw(12) << p.bytesPorElemento << std::endl;
+
+        if (resultados) {
+            for (const std::string& op : operacoesVarredura()) {
+                Estatisticas e;
+                e.minimo = e.mediana = e.p95 = e.media = e.icInferior = e.icSuperior = p.nsPorOp[op];
+                e.amostras = 1;
+                resultados->push_back(criarResultado(nome, op, n, "uniforme", e, p.bytesPorElemento));
+            }
+        }
+        pontos.push_back(p);
+
+        // Reajusta os modelos com o novo ponto (usados para projetar o próximo N)
+        for (const std::string& op : operacoesVarredura()) {
+            std::vector<double> xs, ys;
+            for (const PontoVarredura& q : pontos) {
+                xs.push_back((double)q.n);
+                ys.push_back(std::max(q.nsPorOp.at(op), 1e-3));
+            }
+            ajustes[op] = ajustarComplexidade(xs, ys);
+        }
+    }
+
+    // --- Relatório de ajuste vs. complexidade declarada ---
+    std::cout << "\n" << std::left << std::setw(14) << "Operacao" << std::setw(14) << "Ajuste"
+              << std::setw(12) << "Erro RMS" << std::setw(14) << "Declarado" << "Veredito" << std::endl;
+    for (const std::string& op : operacoesVarredura()) {
+        const AjusteComplexidade& aj = ajustes[op];
+        auto it = declarado.find(op);
+        std::string decl = it != declarado.end() ? nomeComplexidade(it->second) : "-";
+        std::string veredito;
+        if (pontos.size() < 3) veredito = "pontos insuficientes";
+        else if (it == declarado.end()) veredito = "sem declaracao";
+        else if (aj.modelo == it->second) veredito = "confere";
+        else veredito = (aj.modelo > it->second ? "DIVERGE (pior que o declarado)"
+                                                : "diverge (melhor que o declarado)");
+
+        std::cout << std::left << std::setw(14) << op << std::setw(14)
+                  << (aj.valido ? nomeComplexidade(aj.modelo) : "-") << std::setw(12) << std::fixed
+                  << std::setprecision(1) << (aj.rmsRelativo * 100) << std::setw(14) << decl << veredito << std::endl;
+    }
+    return pontos;
+}
+
+#endif
@@ -1,202 +1,305 @@
-#include <iostream>
-#include <vector>
-#include <queue>      // Para priority_queue
-#include <functional> // Para greater<double>
-#include <algorithm>  // Para sort (auxiliar no print)
-
-using namespace std;
-
-class SensorHeap {
-private:
-    // HEAP 1: Armazena a metade MENOR dos dados. 
-    // O topo é o MAIOR dessa metade (candidato à mediana).
-    priority_queue<double> maxHeap; 
-
-    // HEAP 2: Armazena a metade MAIOR dos dados.
-    // O topo é o MENOR dessa metade (candidato à mediana).
-    priority_queue<double, vector<double>, greater<double>> minHeap;
-
-    // Função auxiliar para rebalancear os heaps após inserção/remoção
-    void balanceHeaps() {
-        // A regra é: maxHeap pode ter no máximo 1 elemento a mais que minHeap
-        if (maxHeap.size() > minHeap.size() + 1) {
-            minHeap.push(maxHeap.top());
-            maxHeap.pop();
-        } else if (minHeap.size() > maxHeap.size()) {
-            maxHeap.push(minHeap.top());
-            minHeap.pop();
-        }
-    }
-
-    // Função auxiliar para remover item arbitrário (O ponto fraco do Heap)
-    // C++ STL priority_queue não tem remove(valor), então precisamos reconstruir
-    template <typename T>
-    void removeFromQueue(T& pq, double value) {
-        vector<double> temp;
-        bool removed = false;
-        
-        // Esvazia a fila guardando elementos
-        while (!pq.empty()) {
-            double top = pq.top();
-            pq.pop();
-            
-            // Se achou o valor e ainda não removeu, pula a reinserção
-            if (top == value && !removed) {
-                removed = true;
-            } else {
-                temp.push_back(top);
-            }
-        }
-        
-        // Reinsere tudo
-        for (double v : temp) {
-            pq.push(v);
-        }
-    }
-
-public:
-    // 1. insert(value): O(log N)
-    // Muito rápido. Insere no heap correto e balanceia.
-    void insert(double value) {
-        if (maxHeap.empty() || value < maxHeap.top()) {
-            maxHeap.push(value);
-        } else {
-            minHeap.push(value);
-        }
-        balanceHeaps();
-    }
-
-    // 2. median(): O(1) !!!
-    // Esta é a grande vantagem desta estrutura. Acesso imediato.
-    double median() {
-        if (maxHeap.empty()) return 0.0;
-
-        // Se tamanhos iguais, média dos topos
-        if (maxHeap.size() == minHeap.size()) {
-            return (maxHeap.top() + minHeap.top()) / 2.0;
-        } else {
-            // Se tamanhos diferentes, o maxHeap (que permitimos ter 1 a mais) tem a mediana
-            return maxHeap.top();
-        }
-    }
-
-    // 3. remove(value): O(N)
-    // PONTO FRACO: Heaps não servem para remover itens do meio.
-    // Temos que desmontar e montar de novo.
-    void remove(double value) {
-        // Tenta remover de ambos (não sabemos onde está)
-        // Nota: isso é ineficiente comparado à Árvore AVL
-        removeFromQueue(maxHeap, value);
-        removeFromQueue(minHeap, value);
-        balanceHeaps();
-        cout << "[Remove] Processo de remocao executado para " << value << endl;
-    }
-
-    // 4. getMinMax(k): O(K log N) ou O(1) parcial
-    // O Min global está no topo do minHeap (ou maxHeap se minHeap vazio)
-    // O Max global está... perdido no fundo do minHeap ou no topo.
-    // Heaps só garantem acesso rápido a UM extremo.
-    void getMinMax(int k) {
-        // Para implementar isso genericamente com 2 heaps focados em mediana,
-        // precisamos copiar os dados, pois não temos acesso direto ao "Fundo" do heap.
-        // Isso demonstra uma limitacao da estrutura para esse requisito especifico.
-        
-        vector<double> allData;
-        
-        // Cópia temporária (ineficiente, mas necessário para Heap estrito)
-        priority_queue<double> tempMax = maxHeap;
-        priority_queue<double, vector<double>, greater<double>> tempMin = minHeap;
-        
-        while(!tempMax.empty()) { allData.push_back(tempMax.top()); tempMax.pop(); }
-        while(!tempMin.empty()) { allData.push_back(tempMin.top()); tempMin.pop(); }
-        
-        sort(allData.begin(), allData.end()); // O(N log N)
-        
-        int n = allData.size();
-        k = min(k, n);
-        
-        cout << "--- Extremos (" << k << ") ---" << endl;
-        cout << "Minimos: ";
-        for(int i=0; i<k; i++) cout << allData[i] << " ";
-        cout << "\nMaximos: ";
-        for(int i=0; i<k; i++) cout << allData[n-1-i] << " ";
-        cout << endl;
-    }
-
-    // 5. rangeQuery(x, y): O(N)
-    // PONTO FRACO: Heap não ordena tudo, então precisamos verificar todos os itens.
-    void rangeQuery(double minVal, double maxVal) {
-        cout << "--- Consulta Intervalo [" << minVal << " a " << maxVal << "] ---" << endl;
-        cout << "Resultados: ";
-        
-        // Helper lambda para checar um heap sem destruir
-        auto checkHeap = [&](auto pq) {
-            while (!pq.empty()) {
-                double val = pq.top();
-                pq.pop();
-                if (val >= minVal && val <= maxVal) {
-                    cout << val << " ";
-                }
-            }
-        };
-
-        checkHeap(maxHeap);
-        checkHeap(minHeap);
-        cout << endl;
-    }
-
-    // 6. printSorted(): O(N log N)
-    // Heaps não mantém ordem total, apenas ordem de prioridade.
-    // Para imprimir tudo ordenado, precisamos extrair tudo.
-    void printSorted() {
-        // Copia para não destruir a estrutura original
-        priority_queue<double> tempMax = maxHeap;
-        priority_queue<double, vector<double>, greater<double>> tempMin = minHeap;
-        
-        vector<double> sorted;
-        while(!tempMax.empty()) { sorted.push_back(tempMax.top()); tempMax.pop(); }
-        while(!tempMin.empty()) { sorted.push_back(tempMin.top()); tempMin.pop(); }
-        
-        sort(sorted.begin(), sorted.end());
-        
-        cout << "Heap (Flattened & Sorted): ";
-        for(double v : sorted) cout << v << " | ";
-        cout << endl;
-    }
-};
-
-int main() {
-    SensorHeap heaps;
-    
-    cout << "=== TESTE VERSAO APRIMORADA (TWO HEAPS) ===\n" << endl;
-
-    // 1. Inserções
-    heaps.insert(10.0);
-    heaps.insert(50.0);
-    heaps.insert(30.0);
-    heaps.insert(20.0);
-    heaps.insert(40.0); 
-    // Estado atual ordenado logicamente: 10, 20, 30, 40, 50
-    // Mediana esperada: 30
-    
-    // 2. Teste Mediana O(1)
-    cout << "Mediana (Deve ser 30): " << heaps.median() << endl;
-    
-    heaps.insert(60.0);
-    // Estado: 10, 20, 30, 40, 50, 60
-    // Mediana: (30+40)/2 = 35
-    cout << "Mediana Apos Insercao (Deve ser 35): " << heaps.median() << endl;
-
-    // 3. Teste Min/Max
-    heaps.getMinMax(2);
-
-    // 4. Remoção (O(N) - Lento neste modelo)
-    heaps.remove(30.0); 
-    // Sobra: 10, 20, 40, 50, 60 -> Mediana 40
-    cout << "Mediana Apos Remover 30 (Deve ser 40): " << heaps.median() << endl;
-
-    // 5. Range Query
-    heaps.rangeQuery(15.0, 45.0);
-
-    return 0;
-}
\ No newline at end of file
+#include <iostream>
+#include <vector>
+#include <utility>    // Para swap
+#include <algorithm>  // Para sort (auxiliar no print)
+
+using namespace std;
+
+// Heap min-max: níveis pares (0, 2, ...) são de mínimo e níveis ímpares de máximo.
+// Um nó de nível de mínimo é <= a toda a sua subárvore, um de máximo é >=.
+// Assim o menor fica na raiz e o maior num dos dois filhos dela: os DOIS
+// extremos em O(1), e retirar qualquer um deles custa O(log N).
+class MinMaxHeap {
+private:
+    vector<double> a;
+
+    static bool nivelDeMinimo(size_t i) {
+        int nivel = 0;
+        for (size_t j = i + 1; j > 1; j >>= 1) nivel++;
+        return nivel % 2 == 0;
+    }
+
+    static size_t pai(size_t i) { return (i - 1) / 2; }
+
+    // Sobe 'i' comparando só com avós (mesmo tipo de nível)
+    void subirMesmoTipo(size_t i, bool minimo) {
+        while (i > 2) {
+            size_t avo = pai(pai(i));
+            if (minimo ? a[i] < a[avo] : a[i] > a[avo]) {
+                swap(a[i], a[avo]);
+                i = avo;
+            } else {
+                break;
+            }
+        }
+    }
+
+    void subir(size_t i) {
+        if (i == 0) return;
+        size_t p = pai(i);
+        bool minimo = nivelDeMinimo(i);
+        if (minimo ? a[i] > a[p] : a[i] < a[p]) {
+            swap(a[i], a[p]);
+            subirMesmoTipo(p, !minimo);
+        } else {
+            subirMesmoTipo(i, minimo);
+        }
+    }
+
+    // Desce 'i' até o lugar certo; devolve a posição final do elemento
+    size_t descer(size_t i) {
+        bool minimo = nivelDeMinimo(i);
+        auto melhor = [&](double x, double y) { return minimo ? x < y : x > y; };
+        size_t posicao = i;
+        while (2 * i + 1 < a.size()) {
+            // Extremo entre filhos e netos
+            size_t m = 2 * i + 1;
+            size_t candidatos[] = {2 * i + 2, 4 * i + 3, 4 * i + 4, 4 * i + 5, 4 * i + 6};
+            for (size_t c : candidatos)
+                if (c < a.size() && melhor(a[c], a[m])) m = c;
+
+            if (!melhor(a[m], a[i])) break;
+            swap(a[m], a[i]);
+            if (m <= 2 * i + 2) return posicao == i ? m : posicao; // Filho: a descida termina aqui
+            // Neto: confere com o pai dele (nível do tipo oposto); se trocar, o
+            // elemento que descia fica ali e a descida segue com o outro
+            if (posicao == i) posicao = m;
+            if (melhor(a[pai(m)], a[m])) {
+                swap(a[m], a[pai(m)]);
+                if (posicao == m) posicao = pai(m);
+            }
+            i = m;
+        }
+        return posicao;
+    }
+
+    size_t posicaoMaximo() const {
+        if (a.size() == 1) return 0;
+        if (a.size() == 2) return 1;
+        return a[1] >= a[2] ? 1 : 2;
+    }
+
+    // Retira a posição 'i' trocando pelo último elemento; O(log N)
+    double retirar(size_t i) {
+        double valor = a[i];
+        a[i] = a.back();
+        a.pop_back();
+        if (i < a.size()) subir(descer(i));
+        return valor;
+    }
+
+public:
+    void push(double value) {
+        a.push_back(value);
+        subir(a.size() - 1);
+    }
+
+    double min() const { return a[0]; }
+    double max() const { return a[posicaoMaximo()]; }
+    double popMin() { return retirar(0); }
+    double popMax() { return retirar(posicaoMaximo()); }
+
+    // Remove uma ocorrência de 'value': busca O(N), reparo O(log N)
+    bool erase(double value) {
+        for (size_t i = 0; i < a.size(); i++) {
+            if (a[i] == value) {
+                retirar(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t size() const { return a.size(); }
+    bool empty() const { return a.empty(); }
+    const vector<double>& elementos() const { return a; }
+};
+
+class SensorHeap {
+private:
+    // HEAP 1: Armazena a metade MENOR dos dados.
+    // O máximo dela é candidato à mediana; o mínimo dela é o mínimo global.
+    MinMaxHeap menores;
+
+    // HEAP 2: Armazena a metade MAIOR dos dados.
+    // O mínimo dela é candidato à mediana; o máximo dela é o máximo global.
+    MinMaxHeap maiores;
+
+    bool verbose = true; // Logs de operação (desligar em ingestão contínua)
+
+    // Função auxiliar para rebalancear os heaps após inserção/remoção
+    void balanceHeaps() {
+        // A regra é: 'menores' pode ter no máximo 1 elemento a mais que 'maiores'
+        if (menores.size() > maiores.size() + 1) {
+            maiores.push(menores.popMax());
+        } else if (maiores.size() > menores.size()) {
+            menores.push(maiores.popMin());
+        }
+    }
+
+    // K extremos sem copiar os heaps: retira k elementos pela ponta pedida
+    // (primeiro da metade que contém aquele extremo) e depois devolve cada um
+    // ao heap de origem. O(K log N).
+    vector<double> extremos(int k, bool maiorValor) {
+        vector<double> out;
+        k = max(0, min(k, size()));
+        out.reserve(k);
+        MinMaxHeap& primeiro = maiorValor ? maiores : menores;
+        MinMaxHeap& segundo = maiorValor ? menores : maiores;
+        size_t doPrimeiro = 0;
+        while ((int)out.size() < k) {
+            MinMaxHeap& h = !primeiro.empty() ? primeiro : segundo;
+            if (&h == &primeiro) doPrimeiro++;
+            out.push_back(maiorValor ? h.popMax() : h.popMin());
+        }
+        for (size_t i = 0; i < out.size(); i++) (i < doPrimeiro ? primeiro : segundo).push(out[i]);
+        return out;
+    }
+
+public:
+    // 1. insert(value): O(log N)
+    // Muito rápido. Insere no heap correto e balanceia.
+    void insert(double value) {
+        if (menores.empty() || value < menores.max()) {
+            menores.push(value);
+        } else {
+            maiores.push(value);
+        }
+        balanceHeaps();
+    }
+
+    // 2. median(): O(1) !!!
+    // Esta é a grande vantagem desta estrutura. Acesso imediato.
+    double median() {
+        if (menores.empty()) return 0.0;
+
+        // Se tamanhos iguais, média dos topos
+        if (menores.size() == maiores.size()) {
+            return (menores.max() + maiores.min()) / 2.0;
+        } else {
+            // Se tamanhos diferentes, 'menores' (que permitimos ter 1 a mais) tem a mediana
+            return menores.max();
+        }
+    }
+
+    // 3. remove(value): O(N)
+    // PONTO FRACO: Heaps não servem para BUSCAR itens do meio.
+    // A busca é linear; retirar o item achado custa só O(log N).
+    void remove(double value) {
+        // O valor só pode estar na metade de menores se não passar do máximo dela
+        bool removido = !menores.empty() && value <= menores.max() && menores.erase(value);
+        if (!removido) maiores.erase(value);
+        balanceHeaps();
+        if (verbose) cout << "[Remove] Processo de remocao executado para " << value << endl;
+    }
+
+    void setVerbose(bool v) { verbose = v; }
+
+    int size() { return menores.size() + maiores.size(); }
+
+    // Extremos globais: O(1)
+    // O mínimo global é o mínimo da metade menor; o máximo global, o máximo da maior.
+    double minValue() {
+        if (menores.empty()) return 0.0;
+        return menores.min();
+    }
+
+    double maxValue() {
+        if (menores.empty()) return 0.0;
+        if (maiores.empty()) return menores.max();
+        return maiores.max();
+    }
+
+    // Versões sem impressão (para drivers e benchmarks)
+    // K menores (crescente) / K maiores (decrescente): O(K log N)
+    vector<double> minK(int k) { return extremos(k, false); }
+    vector<double> maxK(int k) { return extremos(k, true); }
+
+    // Leituras em [minVal, maxVal]: O(N), varredura dos vetores internos
+    vector<double> rangeValues(double minVal, double maxVal) {
+        vector<double> out;
+        for (const vector<double>* v : {&menores.elementos(), &maiores.elementos()}) {
+            for (double x : *v) {
+                if (x >= minVal && x <= maxVal) out.push_back(x);
+            }
+        }
+        sort(out.begin(), out.end());
+        return out;
+    }
+
+    // 4. getMinMax(k): O(K log N)
+    // Cada metade é um heap min-max, então os dois extremos globais ficam no
+    // topo e os K seguintes saem por retirada e devolução, sem copiar os dados.
+    void getMinMax(int k) {
+        vector<double> minimos = minK(k);
+        vector<double> maximos = maxK(k);
+
+        cout << "--- Extremos (" << minimos.size() << ") ---" << endl;
+        cout << "Minimos: ";
+        for (double v : minimos) cout << v << " ";
+        cout << "\nMaximos: ";
+        for (double v : maximos) cout << v << " ";
+        cout << endl;
+    }
+
+    // 5. rangeQuery(x, y): O(N)
+    // PONTO FRACO: Heap não ordena tudo, então precisamos verificar todos os itens.
+    void rangeQuery(double minVal, double maxVal) {
+        cout << "--- Consulta Intervalo [" << minVal << " a " << maxVal << "] ---" << endl;
+        cout << "Resultados: ";
+        for (double val : rangeValues(minVal, maxVal)) cout << val << " ";
+        cout << endl;
+    }
+
+    // 6. printSorted(): O(N log N)
+    // Heaps não mantém ordem total, apenas ordem de prioridade.
+    // Para imprimir tudo ordenado, ordenamos uma cópia dos vetores internos.
+    void printSorted() {
+        vector<double> sorted(menores.elementos());
+        sorted.insert(sorted.end(), maiores.elementos().begin(), maiores.elementos().end());
+
+        sort(sorted.begin(), sorted.end());
+
+        cout << "Heap (Flattened & Sorted): ";
+        for(double v : sorted) cout << v << " | ";
+        cout << endl;
+    }
+};
+
+#ifndef SENSOR_SEM_MAIN
+int main() {
+    SensorHeap heaps;
+    
+    cout << "=== TESTE VERSAO APRIMORADA (TWO HEAPS) ===\n" << endl;
+
+    // 1. Inserções
+    heaps.insert(10.0);
+    heaps.insert(50.0);
+    heaps.insert(30.0);
+    heaps.insert(20.0);
+    heaps.insert(40.0); 
+    // Estado atual ordenado logicamente: 10, 20, 30, 40, 50
+    // Mediana esperada: 30
+    
+    // 2. Teste Mediana O(1)
+    cout << "Mediana (Deve ser 30): " << heaps.median() << endl;
+    
+    heaps.insert(60.0);
+    // Estado: 10, 20, 30, 40, 50, 60
+    // Mediana: (30+40)/2 = 35
+    cout << "Mediana Apos Insercao (Deve ser 35): " << heaps.median() << endl;
+
+    // 3. Teste Min/Max
+    heaps.getMinMax(2);
+
+    // 4. Remoção (O(N) - Lento neste modelo)
+    heaps.remove(30.0); 
+    // Sobra: 10, 20, 40, 50, 60 -> Mediana 40
+    cout << "Mediana Apos Remover 30 (Deve ser 40): " << heaps.median() << endl;
+
+    // 5. Range Query
+    heaps.rangeQuery(15.0, 45.0);
+
+    return 0;
+}
+#endif
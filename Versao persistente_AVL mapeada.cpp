@@ -0,0 +1,570 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <iomanip>
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <chrono>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// --- AVL persistente em arquivo mapeado na memória (mmap) ---
+// Mesma árvore de estatística de ordem da SensorAVL (tamanho de subárvore em cada
+// nó), mas os nós moram num arquivo e se ligam por índices (uint32), não por
+// ponteiros. Reabrir o arquivo é O(1): median()/rangeQuery() respondem na hora,
+// sem reconstruir nada.
+//
+// Layout: página 0 com dois slots de cabeçalho; nó i no offset 4096 + 32*i
+// (índice 0 = nulo).
+//
+// Consistência contra escritas rasgadas (queda no meio de uma gravação):
+//  - Cópia no caminho: um nó já confirmado nunca é alterado; inserir/remover
+//    copia os nós do caminho até a raiz e a versão antiga continua intacta.
+//  - Confirmação: msync dos nós e depois do cabeçalho no slot alternado, com
+//    geração + checksum. Ao abrir vale o slot válido de maior geração; um
+//    cabeçalho rasgado falha no checksum e a versão anterior é usada.
+//  - Nós substituídos só são reaproveitados depois da confirmação seguinte,
+//    quando nenhum cabeçalho válido aponta mais para eles.
+//  - A lista de nós livres só é gravada no fechamento limpo; após uma queda
+//    esses nós ficam perdidos no arquivo (vazamento, nunca corrupção).
+// Operações desde a última confirmação se perdem numa queda: confirmação
+// automática a cada 'confirmarACada' operações, ou manual com sync().
+
+struct NodeMap {
+    double key;
+    uint32_t left, right; // Índices dos filhos (0 = nulo)
+    uint32_t size;        // Tamanho da subárvore
+    int32_t height;
+    uint64_t generation;  // Transação que criou o nó (só esta pode alterá-lo no lugar)
+};
+static_assert(sizeof(NodeMap) == 32, "layout do no no arquivo deve ter 32 bytes");
+
+struct MapHeader {
+    uint64_t magic;
+    uint64_t generation;
+    uint32_t root;
+    uint32_t used;       // Próximo índice nunca usado
+    uint32_t freeHead;   // Lista de livres encadeada por 'left' (só se cleanClose)
+    uint32_t cleanClose;
+    uint64_t checksum;   // FNV-1a dos campos anteriores
+};
+
+class SensorAVLMapeada {
+private:
+    static const uint64_t MAGIC = 0x31504D4D4C5641ULL; // "AVLMMP1"
+    static const size_t HEADER_PAGE = 4096;
+    static const size_t HEADER_SLOT = 64;
+    static const uint32_t INITIAL_NODES = 1024;
+
+    int fd = -1;
+    char* base = nullptr;
+    size_t mapSize = 0;
+    uint32_t capacity = 0;     // Nós que cabem no arquivo
+    string error;
+
+    uint32_t root = 0, used = 1;
+    uint64_t generation = 0;   // Última geração confirmada; a transação aberta é generation + 1
+    vector<uint32_t> freeNodes;    // Reaproveitáveis já
+    vector<uint32_t> retired;      // Substituídos nesta transação (livres após confirmar)
+    uint32_t fileFreeChain = 0;    // Lista livre herdada do fechamento limpo (consumida aos poucos)
+    size_t opsSinceSync = 0;
+    size_t syncEvery = 1000;
+    bool verbose = true;
+    bool durable = true;           // false no arquivo temporário: confirma sem msync
+
+    NodeMap& node(uint32_t i) { return reinterpret_cast<NodeMap*>(base + HEADER_PAGE)[i]; }
+    uint64_t txn() const { return generation + 1; }
+
+    static uint64_t checksum(const MapHeader& h) {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(&h);
+        uint64_t x = 1469598103934665603ULL;
+        for (size_t i = 0; i < offsetof(MapHeader, checksum); i++) x = (x ^ p[i]) * 1099511628211ULL;
+        return x;
+    }
+
+    bool fail(const string& what) {
+        error = what + ": " + strerror(errno);
+        return false;
+    }
+
+    // Aumenta o arquivo (e o mapa) para caber pelo menos 'nodes' nós
+    bool grow(uint32_t nodes) {
+        uint64_t newCap = max<uint64_t>(capacity ? capacity : INITIAL_NODES, INITIAL_NODES);
+        while (newCap < nodes) newCap *= 2;
+        if (newCap > UINT32_MAX) newCap = UINT32_MAX;
+        size_t newSize = HEADER_PAGE + newCap * sizeof(NodeMap);
+        if (ftruncate(fd, newSize) != 0) return fail("ftruncate");
+        void* m = base ? mremap(base, mapSize, newSize, MREMAP_MAYMOVE)
+                       : mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (m == MAP_FAILED) return fail("mmap");
+        base = static_cast<char*>(m);
+        mapSize = newSize;
+        capacity = (uint32_t)newCap;
+        return true;
+    }
+
+    uint32_t allocate() {
+        if (!freeNodes.empty()) {
+            uint32_t i = freeNodes.back();
+            freeNodes.pop_back();
+            return i;
+        }
+        if (fileFreeChain != 0) {
+            uint32_t i = fileFreeChain;
+            fileFreeChain = node(i).left;
+            return i;
+        }
+        if (used >= capacity && !grow(used + 1)) {
+            cerr << "[ERRO] AVL mapeada: " << error << endl;
+            abort(); // Sem espaço em disco: não há como continuar a operação pela metade
+        }
+        return used++;
+    }
+
+    uint32_t newNode(double key) {
+        uint32_t i = allocate();
+        node(i) = NodeMap{key, 0, 0, 1, 1, txn()};
+        return i;
+    }
+
+    // Versão alterável de 'i': o próprio nó se já é desta transação, senão uma cópia
+    uint32_t writable(uint32_t i) {
+        if (node(i).generation == txn()) return i;
+        uint32_t c = allocate(); // Pode remapear: não guardar referências antes
+        node(c) = node(i);
+        node(c).generation = txn();
+        retired.push_back(i);
+        return c;
+    }
+
+    void release(uint32_t i) {
+        if (node(i).generation == txn()) freeNodes.push_back(i); // Nenhuma versão confirmada o vê
+        else retired.push_back(i);
+    }
+
+    int height(uint32_t i) { return i ? node(i).height : 0; }
+    uint32_t getSize(uint32_t i) { return i ? node(i).size : 0; }
+    int getBalance(uint32_t i) { return i ? height(node(i).left) - height(node(i).right) : 0; }
+
+    void update(uint32_t i) {
+        NodeMap& n = node(i);
+        n.height = 1 + max(height(n.left), height(n.right));
+        n.size = 1 + getSize(n.left) + getSize(n.right);
+    }
+
+    // Rotações recebem 'y' já alterável e copiam o filho que sobe
+    uint32_t rightRotate(uint32_t y) {
+        uint32_t x = writable(node(y).left);
+        node(y).left = node(x).right;
+        node(x).right = y;
+        update(y);
+        update(x);
+        return x;
+    }
+
+    uint32_t leftRotate(uint32_t x) {
+        uint32_t y = writable(node(x).right);
+        node(x).right = node(y).left;
+        node(y).left = x;
+        update(x);
+        update(y);
+        return y;
+    }
+
+    uint32_t rebalance(uint32_t n) {
+        update(n);
+        int balance = getBalance(n);
+        if (balance > 1) {
+            if (getBalance(node(n).left) < 0) {
+                uint32_t l = leftRotate(writable(node(n).left));
+                node(n).left = l;
+            }
+            return rightRotate(n);
+        }
+        if (balance < -1) {
+            if (getBalance(node(n).right) > 0) {
+                uint32_t r = rightRotate(writable(node(n).right));
+                node(n).right = r;
+            }
+            return leftRotate(n);
+        }
+        return n;
+    }
+
+    uint32_t insert(uint32_t n, double key) {
+        if (n == 0) return newNode(key);
+        n = writable(n);
+        if (key < node(n).key) {
+            uint32_t l = insert(node(n).left, key);
+            node(n).left = l;
+        } else {
+            uint32_t r = insert(node(n).right, key);
+            node(n).right = r;
+        }
+        return rebalance(n);
+    }
+
+    // Só copia o caminho se a chave existir
+    uint32_t remove(uint32_t n, double key, bool& found) {
+        if (n == 0) return 0;
+        if (key < node(n).key) {
+            uint32_t l = remove(node(n).left, key, found);
+            if (!found) return n;
+            n = writable(n);
+            node(n).left = l;
+        } else if (key > node(n).key) {
+            uint32_t r = remove(node(n).right, key, found);
+            if (!found) return n;
+            n = writable(n);
+            node(n).right = r;
+        } else {
+            found = true;
+            if (node(n).left == 0 || node(n).right == 0) {
+                uint32_t child = node(n).left ? node(n).left : node(n).right;
+                release(n);
+                return child;
+            }
+            // Dois filhos: sobe o sucessor (menor da direita)
+            uint32_t s = node(n).right;
+            while (node(s).left) s = node(s).left;
+            double succ = node(s).key;
+            uint32_t r = remove(node(n).right, succ, found);
+            n = writable(n);
+            node(n).key = succ;
+            node(n).right = r;
+        }
+        return rebalance(n);
+    }
+
+    uint32_t buildFromSorted(const vector<double>& v, long lo, long hi) {
+        if (lo > hi) return 0;
+        long mid = lo + (hi - lo) / 2;
+        uint32_t n = newNode(v[mid]);
+        uint32_t l = buildFromSorted(v, lo, mid - 1);
+        uint32_t r = buildFromSorted(v, mid + 1, hi);
+        node(n).left = l;
+        node(n).right = r;
+        update(n);
+        return n;
+    }
+
+    // k-ésimo menor (0-indexado)
+    double select(uint32_t k) {
+        uint32_t n = root;
+        while (n) {
+            uint32_t leftSize = getSize(node(n).left);
+            if (k < leftSize) n = node(n).left;
+            else if (k == leftSize) return node(n).key;
+            else {
+                k -= leftSize + 1;
+                n = node(n).right;
+            }
+        }
+        return 0.0;
+    }
+
+    void rangeRec(uint32_t n, double lo, double hi, vector<double>& out) {
+        if (n == 0) return;
+        if (lo < node(n).key) rangeRec(node(n).left, lo, hi, out);
+        if (lo <= node(n).key && node(n).key <= hi) out.push_back(node(n).key);
+        if (hi > node(n).key) rangeRec(node(n).right, lo, hi, out);
+    }
+
+    void inOrder(uint32_t n, int& k, vector<double>& out, bool ascending) {
+        if (n == 0 || k <= 0) return;
+        inOrder(ascending ? node(n).left : node(n).right, k, out, ascending);
+        if (k > 0) {
+            out.push_back(node(n).key);
+            k--;
+        }
+        inOrder(ascending ? node(n).right : node(n).left, k, out, ascending);
+    }
+
+    // Grava a versão atual: nós primeiro, cabeçalho depois (slot da próxima geração)
+    void commit(bool clean) {
+        if (durable) msync(base + HEADER_PAGE, mapSize - HEADER_PAGE, MS_SYNC);
+        MapHeader h{MAGIC, txn(), root, used, clean ? fileFreeChain : 0, clean ? 1u : 0u, 0};
+        h.checksum = checksum(h);
+        memcpy(base + (h.generation % 2) * HEADER_SLOT, &h, sizeof(h));
+        if (durable) msync(base, HEADER_PAGE, MS_SYNC);
+        generation = h.generation;
+        freeNodes.insert(freeNodes.end(), retired.begin(), retired.end());
+        retired.clear();
+        opsSinceSync = 0;
+    }
+
+    void afterWrite() {
+        if (++opsSinceSync >= syncEvery) commit(false);
+    }
+
+    bool openFile(const string& path) {
+        fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) return fail("abrir '" + path + "'");
+        struct stat st;
+        if (fstat(fd, &st) != 0) return fail("fstat");
+
+        if ((size_t)st.st_size < HEADER_PAGE + INITIAL_NODES * sizeof(NodeMap)) {
+            if (!grow(INITIAL_NODES)) return false;
+        } else {
+            mapSize = st.st_size;
+            capacity = (uint32_t)min<uint64_t>((mapSize - HEADER_PAGE) / sizeof(NodeMap), UINT32_MAX);
+            void* m = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (m == MAP_FAILED) return fail("mmap");
+            base = static_cast<char*>(m);
+        }
+
+        // Slot válido de maior geração
+        const MapHeader* best = nullptr;
+        bool anyWritten = false;
+        for (int s = 0; s < 2; s++) {
+            const MapHeader* h = reinterpret_cast<const MapHeader*>(base + s * HEADER_SLOT);
+            if (h->magic != 0) anyWritten = true;
+            if (h->magic != MAGIC || h->checksum != checksum(*h) || h->used > capacity) continue;
+            if (!best || h->generation > best->generation) best = h;
+        }
+        if (!best && anyWritten) {
+            error = "'" + path + "' nao tem cabecalho valido (nao e um indice ou os dois slots estao corrompidos)";
+            return false;
+        }
+        if (best) {
+            generation = best->generation;
+            root = best->root;
+            used = best->used;
+            if (best->cleanClose) fileFreeChain = best->freeHead;
+        }
+        // Marca "em uso" antes de reaproveitar a lista livre herdada
+        commit(false);
+        return true;
+    }
+
+public:
+    // Arquivo temporário anônimo (apagado ao fechar): mesma estrutura, sem persistência
+    SensorAVLMapeada() {
+        char path[] = "/tmp/sensor_avl_mapeada_XXXXXX";
+        int tmp = mkstemp(path);
+        if (tmp < 0) {
+            fail("mkstemp");
+            return;
+        }
+        ::close(tmp);
+        durable = false;
+        openFile(path);
+        unlink(path);
+    }
+
+    // Abre (ou cria) o índice em 'path'. Conferir ok() depois.
+    explicit SensorAVLMapeada(const string& path) { openFile(path); }
+
+    ~SensorAVLMapeada() { close(); }
+
+    SensorAVLMapeada(const SensorAVLMapeada&) = delete;
+    SensorAVLMapeada& operator=(const SensorAVLMapeada&) = delete;
+
+    bool ok() const { return base != nullptr && error.empty(); }
+    const string& lastError() const { return error; }
+
+    // Fechamento limpo: confirma, grava a lista de livres e desmapeia
+    void close() {
+        if (base == nullptr) return;
+        commit(false);
+        // Livres deste ponto não são vistos por nenhum cabeçalho válido: podem virar lista
+        for (uint32_t i : freeNodes) {
+            node(i).left = fileFreeChain;
+            fileFreeChain = i;
+        }
+        freeNodes.clear();
+        commit(true);
+        munmap(base, mapSize);
+        ::close(fd);
+        base = nullptr;
+        fd = -1;
+    }
+
+    // Confirma agora (durável ao retornar)
+    void sync() {
+        if (base) commit(false);
+    }
+
+    void setSyncEvery(size_t n) { syncEvery = n ? n : 1; }
+    void setVerbose(bool v) { verbose = v; }
+
+    // --- Mesma API da SensorAVL ---
+    void insert(double value) {
+        if (!base) return;
+        root = insert(root, value);
+        afterWrite();
+    }
+
+    void remove(double value) {
+        if (!base) return;
+        bool found = false;
+        root = remove(root, value, found);
+        if (verbose) cout << "[Remove] Tentativa de remover " << value << endl;
+        if (found) afterWrite();
+    }
+
+    // Carga em O(N) a partir de valores ordenados (árvore vazia); senão insere um a um
+    void bulkLoad(const vector<double>& sorted) {
+        if (!base) return;
+        if (root != 0) {
+            for (double v : sorted) root = insert(root, v);
+        } else {
+            root = buildFromSorted(sorted, 0, (long)sorted.size() - 1);
+        }
+        commit(false);
+    }
+
+    int size() { return base ? (int)getSize(root) : 0; }
+
+    double minValue() {
+        if (!base || root == 0) return 0.0;
+        uint32_t n = root;
+        while (node(n).left) n = node(n).left;
+        return node(n).key;
+    }
+
+    double maxValue() {
+        if (!base || root == 0) return 0.0;
+        uint32_t n = root;
+        while (node(n).right) n = node(n).right;
+        return node(n).key;
+    }
+
+    vector<double> minK(int k) {
+        vector<double> out;
+        if (base) inOrder(root, k, out, true);
+        return out;
+    }
+
+    vector<double> maxK(int k) {
+        vector<double> out;
+        if (base) inOrder(root, k, out, false);
+        return out;
+    }
+
+    vector<double> rangeValues(double minVal, double maxVal) {
+        vector<double> out;
+        if (base) rangeRec(root, minVal, maxVal, out);
+        return out;
+    }
+
+    void printSorted() {
+        cout << "AVL Mapeada Ordenada: ";
+        for (double v : minK(size())) cout << v << " ";
+        cout << endl;
+    }
+
+    void getMinMax(int k) {
+        cout << "--- Extremos (" << k << ") ---" << endl;
+        cout << "Minimos: ";
+        for (double v : minK(k)) cout << v << " ";
+        cout << endl;
+        cout << "Maximos: ";
+        for (double v : maxK(k)) cout << v << " ";
+        cout << endl;
+    }
+
+    void rangeQuery(double minVal, double maxVal) {
+        cout << "--- Consulta Intervalo [" << minVal << " a " << maxVal << "] ---" << endl;
+        cout << "Resultados: ";
+        for (double v : rangeValues(minVal, maxVal)) cout << v << " ";
+        cout << endl;
+    }
+
+    double median() {
+        uint32_t n = base ? getSize(root) : 0;
+        if (n == 0) return 0.0;
+        if (n % 2 != 0) return select(n / 2);
+        return (select(n / 2 - 1) + select(n / 2)) / 2.0;
+    }
+
+    // Diagnóstico: nós ocupados no arquivo (vivos + livres + vazados)
+    uint32_t nodesInFile() const { return used - 1; }
+    uint64_t currentGeneration() const { return generation; }
+};
+
+// --- Teste Principal ---
+// Uso: ./avl_mapeada ARQUIVO [--criar N]
+//   --criar N  recria o índice com N leituras aleatórias antes de reabrir
+#ifndef SENSOR_SEM_MAIN
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cerr << "Uso: avl_mapeada ARQUIVO [--criar N]" << endl;
+        return 1;
+    }
+    string path = argv[1];
+    long long criar = (argc >= 4 && string(argv[2]) == "--criar") ? atoll(argv[3]) : 0;
+
+    cout << "=== TESTE VERSAO PERSISTENTE (AVL MAPEADA) ===\n" << endl;
+
+    if (criar > 0) {
+        unlink(path.c_str());
+        mt19937_64 rng(42);
+        uniform_real_distribution<double> temp(-10.0, 45.0);
+        vector<double> dados(criar);
+        for (double& v : dados) v = round(temp(rng) * 100) / 100;
+        sort(dados.begin(), dados.end());
+
+        auto t0 = chrono::steady_clock::now();
+        SensorAVLMapeada avl(path);
+        if (!avl.ok()) {
+            cerr << "[ERRO] " << avl.lastError() << endl;
+            return 1;
+        }
+        avl.setVerbose(false);
+        avl.bulkLoad(dados);
+        // Algumas alterações depois da carga (copiam só o caminho)
+        for (int i = 0; i < 1000; i++) avl.insert(temp(rng));
+        for (int i = 0; i < 500; i++) avl.remove(dados[i * 7 % dados.size()]);
+        avl.close();
+        chrono::duration<double> d = chrono::steady_clock::now() - t0;
+        cout << "Criado '" << path << "' com " << criar << " leituras em " << fixed << setprecision(2)
+             << d.count() << " s" << endl;
+    }
+
+    // Reabertura: nada é reconstruído, as consultas leem direto do arquivo
+    auto t0 = chrono::steady_clock::now();
+    SensorAVLMapeada avl(path);
+    if (!avl.ok()) {
+        cerr << "[ERRO] " << avl.lastError() << endl;
+        return 1;
+    }
+    double med = avl.median();
+    chrono::duration<double, milli> d = chrono::steady_clock::now() - t0;
+    cout << "Reaberto em " << fixed << setprecision(3) << d.count() << " ms (incluindo a primeira mediana)" << endl;
+    cout << "Leituras: " << avl.size() << " | geracao: " << avl.currentGeneration()
+         << " | nos no arquivo: " << avl.nodesInFile() << endl;
+    cout << setprecision(2) << "Mediana: " << med << " | Min: " << avl.minValue() << " | Max: " << avl.maxValue() << endl;
+    cout << "Leituras em [20.00, 20.05]: " << avl.rangeValues(20.0, 20.05).size() << endl;
+
+    if (criar == 0 && avl.size() == 0) {
+        // Arquivo novo: mesmo roteiro da SensorAVL
+        avl.insert(10.0);
+        avl.insert(20.0);
+        avl.insert(30.0);
+        avl.insert(40.0);
+        avl.insert(50.0);
+        avl.insert(25.0);
+        avl.printSorted();
+        cout << "Mediana (deve ser 27.5): " << avl.median() << endl;
+        avl.rangeQuery(15.0, 35.0);
+        avl.getMinMax(2);
+        avl.remove(30.0);
+        avl.printSorted();
+        cout << "Nova Mediana (deve ser 25.0): " << avl.median() << endl;
+        cout << "(Rode de novo com o mesmo arquivo: os valores continuam la.)" << endl;
+    }
+    return 0;
+}
+#endif